@@ -0,0 +1,163 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth;
+
+import com.aws.greengrass.clientdevices.auth.configuration.AuthorizationPolicyStatement;
+import com.aws.greengrass.clientdevices.auth.configuration.GroupConfiguration;
+import com.aws.greengrass.clientdevices.auth.configuration.GroupDefinition;
+import com.aws.greengrass.clientdevices.auth.configuration.GroupManager;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ParseException;
+import com.aws.greengrass.clientdevices.auth.exception.AuthorizationException;
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import com.aws.greengrass.clientdevices.auth.session.SessionImpl;
+import com.aws.greengrass.clientdevices.auth.session.SessionManager;
+import com.aws.greengrass.clientdevices.auth.session.SessionManagerBenchmark;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Benchmarks of the client device authorization path, swept over group count, permissions per group and the
+ * share of wildcard selection rules and resources. Thread counts are swept by {@link BenchmarkRunner}.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(value = 1, jvmArgsAppend = "-Xmx4g")
+@State(Scope.Benchmark)
+public class AuthorizationBenchmark {
+    private static final String SESSION_ID = "benchmark-session";
+    // Larger than the per-session decision cache, so rotating through them exercises evaluation
+    private static final int RESOURCE_COUNT = 256;
+
+    @Param({"10", "1000", "10000"})
+    public int groupCount;
+
+    @Param({"1", "10", "100"})
+    public int permissionsPerGroup;
+
+    // Percentage of selection rules using 'thingName: prefix*' and of resources using MQTT wildcards
+    @Param({"0", "50", "100"})
+    public int wildcardPercent;
+
+    private GroupManager groupManager;
+    private DeviceAuthClient deviceAuthClient;
+    private Session session;
+    private AuthorizationRequest[] requests;
+
+    /**
+     * Build a group configuration and a session of a device belonging to a single group.
+     *
+     * @throws ParseException         if a selection rule is invalid
+     * @throws AuthorizationException if the configuration is invalid
+     */
+    @Setup(Level.Trial)
+    public void setup() throws ParseException, AuthorizationException {
+        Map<String, GroupDefinition> definitions = new HashMap<>();
+        Map<String, Map<String, AuthorizationPolicyStatement>> policies = new HashMap<>();
+        for (int i = 0; i < groupCount; i++) {
+            boolean wildcard = isWildcard(i);
+            definitions.put("group-" + i, GroupDefinition.builder()
+                    .selectionRule(wildcard ? "thingName: thing-" + i + "-*" : "thingName: thing-" + i + "-0")
+                    .policyName("policy-" + i)
+                    .build());
+            Set<String> resources = new HashSet<>();
+            for (int j = 0; j < permissionsPerGroup; j++) {
+                resources.add(isWildcard(j) ? "mqtt:topic:group-" + i + "/+/topic-" + j
+                        : "mqtt:topic:group-" + i + "/device/topic-" + j);
+            }
+            policies.put("policy-" + i, Collections.singletonMap("statement",
+                    AuthorizationPolicyStatement.builder()
+                            .effect(AuthorizationPolicyStatement.Effect.ALLOW)
+                            .operations(Collections.singleton("mqtt:publish"))
+                            .resources(resources)
+                            .build()));
+        }
+        groupManager = new GroupManager();
+        groupManager.setGroupConfiguration(
+                GroupConfiguration.builder().definitions(definitions).policies(policies).build());
+
+        session = new SessionImpl(new Certificate("certificateId"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("thing-" + (groupCount / 2) + "-0"));
+        SessionManager sessionManager = new SessionManager();
+        SessionManagerBenchmark.addSession(sessionManager, SESSION_ID, session);
+        deviceAuthClient = new DeviceAuthClient(sessionManager, groupManager, null);
+
+        requests = new AuthorizationRequest[RESOURCE_COUNT];
+        for (int i = 0; i < RESOURCE_COUNT; i++) {
+            requests[i] = AuthorizationRequest.builder()
+                    .sessionId(SESSION_ID)
+                    .operation("mqtt:publish")
+                    .resource("mqtt:topic:group-" + (groupCount / 2) + "/device/topic-" + (i % permissionsPerGroup)
+                            + (i < permissionsPerGroup ? "" : "/unmatched-" + i))
+                    .build();
+        }
+    }
+
+    private boolean isWildcard(int i) {
+        return i % 100 < wildcardPercent;
+    }
+
+    @Benchmark
+    public boolean canDevicePerformCached() throws AuthorizationException {
+        return deviceAuthClient.canDevicePerform(requests[0]);
+    }
+
+    @Benchmark
+    public boolean canDevicePerformRotatingResources(RequestCursor cursor) throws AuthorizationException {
+        return deviceAuthClient.canDevicePerform(requests[cursor.next()]);
+    }
+
+    @Benchmark
+    public boolean isAuthorized(RequestCursor cursor) {
+        AuthorizationRequest request = requests[cursor.next()];
+        return PermissionEvaluationUtils.isAuthorized(request.getOperation(), request.getResource(),
+                groupManager.getApplicablePermissionIndexes(session), session);
+    }
+
+    @Benchmark
+    public Object getApplicablePermissionIndexes() {
+        return groupManager.getApplicablePermissionIndexes(session);
+    }
+
+    @Benchmark
+    public Object getApplicablePermissionIndexesUncached() {
+        session.setGroupMembership(null);
+        return groupManager.getApplicablePermissionIndexes(session);
+    }
+
+    /**
+     * Per-thread position in the request array.
+     */
+    @State(Scope.Thread)
+    public static class RequestCursor {
+        private int position;
+
+        int next() {
+            position = (position + 1) % RESOURCE_COUNT;
+            return position;
+        }
+    }
+}
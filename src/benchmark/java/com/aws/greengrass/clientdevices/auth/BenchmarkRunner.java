@@ -0,0 +1,55 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth;
+
+import org.openjdk.jmh.profile.GCProfiler;
+import org.openjdk.jmh.results.format.ResultFormatType;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+import java.io.File;
+
+/**
+ * Runs the JMH benchmarks once per thread count, with the GC profiler enabled so that allocation rates are
+ * reported next to ns/op. Results of each run are written as JSON to 'jmh-result-threads-N.json' in the
+ * output directory.
+ *
+ * <p>Arguments: benchmark include regex, comma separated thread counts, output directory.</p>
+ */
+public final class BenchmarkRunner {
+    private static final String DEFAULT_INCLUDES = ".*";
+    private static final String DEFAULT_THREAD_COUNTS = "1,2,4,8,16,32";
+    private static final String DEFAULT_OUTPUT_DIRECTORY = "target";
+
+    private BenchmarkRunner() {
+    }
+
+    /**
+     * Entry point.
+     *
+     * @param args include regex, thread counts and output directory, all optional
+     * @throws RunnerException if a benchmark fails
+     */
+    public static void main(String[] args) throws RunnerException {
+        String includes = args.length > 0 ? args[0] : DEFAULT_INCLUDES;
+        String threadCounts = args.length > 1 ? args[1] : DEFAULT_THREAD_COUNTS;
+        File outputDirectory = new File(args.length > 2 ? args[2] : DEFAULT_OUTPUT_DIRECTORY);
+
+        for (String threadCount : threadCounts.split(",")) {
+            int threads = Integer.parseInt(threadCount.trim());
+            Options options = new OptionsBuilder()
+                    .include(includes)
+                    .threads(threads)
+                    .addProfiler(GCProfiler.class)
+                    .resultFormat(ResultFormatType.JSON)
+                    .result(new File(outputDirectory, "jmh-result-threads-" + threads + ".json").getPath())
+                    .build();
+            new Runner(options).run();
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth;
+
+import com.aws.greengrass.clientdevices.auth.configuration.Permission;
+import com.aws.greengrass.clientdevices.auth.configuration.PermissionIndex;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+import org.openjdk.jmh.infra.Blackhole;
+
+import java.util.Collections;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/**
+ * Compares operation and resource parsing against the regular expression based parsing it replaced, and
+ * measures parsing together with evaluation against a compiled permission index.
+ * Run through BenchmarkRunner, which enables the GC profiler, to get bytes/op.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+@State(Scope.Benchmark)
+public class PermissionParsingBenchmark {
+    // Regular expressions previously used by PermissionEvaluationUtils
+    private static final Pattern SERVICE_OPERATION_PATTERN = Pattern.compile("([a-zA-Z]+):([a-zA-Z0-9-_]+)");
+    private static final Pattern SERVICE_RESOURCE_PATTERN =
+            Pattern.compile("([a-zA-Z]+):([a-zA-Z]+):([\\w -\\/:-@\\[-\\`{-~]+)", Pattern.UNICODE_CHARACTER_CLASS);
+
+    @Param({"mqtt:topic:sensors/temperature", "mqtt:topic:building/floor-3/room-12/sensors/+/temperature/#"})
+    public String resource;
+
+    public String operation = "mqtt:publish";
+
+    private final List<PermissionIndex> permissionIndexes = Collections.singletonList(PermissionIndex.compile(
+            Collections.singleton(Permission.builder().principal("benchmark").operation("mqtt:publish")
+                    .resource("mqtt:topic:building/#").build())));
+
+    @Benchmark
+    public void singlePassParser(Blackhole blackhole) {
+        blackhole.consume(PermissionEvaluationUtils.parseOperation(operation));
+        blackhole.consume(PermissionEvaluationUtils.parseResource(resource));
+    }
+
+    @Benchmark
+    public boolean parseAndEvaluate() {
+        return PermissionEvaluationUtils.isAuthorized(operation, resource, permissionIndexes);
+    }
+
+    @Benchmark
+    public void regexParser(Blackhole blackhole) {
+        Matcher operationMatcher = SERVICE_OPERATION_PATTERN.matcher(operation);
+        if (operationMatcher.matches()) {
+            String service = operationMatcher.group(1);
+            String action = operationMatcher.group(2);
+            blackhole.consume(String.format("%s:%s", service, action));
+        }
+        Matcher resourceMatcher = SERVICE_RESOURCE_PATTERN.matcher(resource);
+        if (resourceMatcher.matches()) {
+            String service = resourceMatcher.group(1);
+            String resourceType = resourceMatcher.group(2);
+            String resourceName = resourceMatcher.group(3);
+            blackhole.consume(String.format("%s:%s:%s", service, resourceType, resourceName));
+        }
+    }
+}
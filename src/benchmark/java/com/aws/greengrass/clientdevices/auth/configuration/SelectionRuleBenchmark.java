@@ -0,0 +1,73 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ParseException;
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import com.aws.greengrass.clientdevices.auth.session.SessionImpl;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Compares evaluating compiled selection rules against walking the expression tree with {@link ExpressionVisitor},
+ * for OR chains of increasing length. The session matches the last term, so every term is evaluated.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(value = 1, jvmArgsAppend = "-Xss8m")
+@State(Scope.Benchmark)
+public class SelectionRuleBenchmark {
+    @Param({"1", "10", "100", "500"})
+    public int terms;
+
+    private GroupDefinition groupDefinition;
+    private Session session;
+
+    /**
+     * Build a selection rule of the form 'thingName: thing-0 OR ... OR thingName: thing-N'.
+     *
+     * @throws ParseException if the selection rule is invalid
+     */
+    @Setup(Level.Trial)
+    public void setup() throws ParseException {
+        StringBuilder rule = new StringBuilder();
+        for (int i = 0; i < terms; i++) {
+            if (i > 0) {
+                rule.append(" OR ");
+            }
+            rule.append("thingName: thing-").append(i);
+        }
+        groupDefinition = new GroupDefinition(rule.toString(), "policy");
+        session = new SessionImpl(new Certificate("certificateId"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("thing-" + (terms - 1)));
+    }
+
+    @Benchmark
+    public boolean compiledRule() {
+        return groupDefinition.containsClientDevice(session);
+    }
+
+    @Benchmark
+    public boolean expressionVisitor() {
+        return (boolean) new ExpressionVisitor().visit(groupDefinition.getExpressionTree(), session);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Benchmarks of session lookups, swept over the number of open sessions. Thread counts are swept by
+ * {@link com.aws.greengrass.clientdevices.auth.BenchmarkRunner}, which shows how lookups scale with
+ * concurrent readers. The synchronized access-ordered map the session cache replaced is measured alongside
+ * as a baseline.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+@State(Scope.Benchmark)
+public class SessionManagerBenchmark {
+    // Up to the default session capacity, above which the least recently used sessions are evicted
+    @Param({"10", "1000", "2500"})
+    public int sessionCount;
+
+    private SessionManager sessionManager;
+    private Map<String, Session> synchronizedSessionMap;
+    private String[] sessionIds;
+
+    /**
+     * Open sessions directly, bypassing credential validation.
+     */
+    @Setup(Level.Trial)
+    public void setup() {
+        sessionManager = new SessionManager();
+        synchronizedSessionMap = Collections.synchronizedMap(new LinkedHashMap<>(sessionCount, 0.75f, true));
+        sessionIds = new String[sessionCount];
+        for (int i = 0; i < sessionCount; i++) {
+            sessionIds[i] = "session-" + i;
+            Session session = new SessionImpl(new Certificate("certificate-" + i));
+            addSession(sessionManager, sessionIds[i], session);
+            synchronizedSessionMap.put(sessionIds[i], session);
+        }
+    }
+
+    /**
+     * Register a session under a fixed id, bypassing credential validation.
+     *
+     * @param sessionManager session manager
+     * @param sessionId      session id
+     * @param session        session
+     */
+    public static void addSession(SessionManager sessionManager, String sessionId, Session session) {
+        sessionManager.putSession(sessionId, session);
+    }
+
+    @Benchmark
+    public Session findSession() {
+        return sessionManager.findSession(sessionIds[ThreadLocalRandom.current().nextInt(sessionCount)]);
+    }
+
+    @Benchmark
+    public Session findSessionSynchronizedMapBaseline() {
+        return synchronizedSessionMap.get(sessionIds[ThreadLocalRandom.current().nextInt(sessionCount)]);
+    }
+}
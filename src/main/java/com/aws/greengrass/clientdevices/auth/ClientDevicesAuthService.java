@@ -9,13 +9,19 @@ import com.aws.greengrass.authorization.AuthorizationHandler;
 import com.aws.greengrass.clientdevices.auth.api.ClientDevicesAuthServiceApi;
 import com.aws.greengrass.clientdevices.auth.certificate.CertificateStore;
 import com.aws.greengrass.clientdevices.auth.certificate.CertificatesConfig;
-import com.aws.greengrass.clientdevices.auth.configuration.GroupConfiguration;
+import com.aws.greengrass.clientdevices.auth.configuration.CompiledRuleCache;
+import com.aws.greengrass.clientdevices.auth.configuration.GroupConfigurationConverter;
 import com.aws.greengrass.clientdevices.auth.configuration.GroupManager;
+import com.aws.greengrass.clientdevices.auth.exception.AuthorizationException;
 import com.aws.greengrass.clientdevices.auth.exception.CloudServiceInteractionException;
+import com.aws.greengrass.clientdevices.auth.iot.CertificateRegistry;
+import com.aws.greengrass.clientdevices.auth.iot.IotAuthCacheConfig;
+import com.aws.greengrass.clientdevices.auth.iot.IotAuthClient;
 import com.aws.greengrass.clientdevices.auth.session.MqttSessionFactory;
 import com.aws.greengrass.clientdevices.auth.session.SessionConfig;
 import com.aws.greengrass.clientdevices.auth.session.SessionCreator;
 import com.aws.greengrass.clientdevices.auth.session.SessionManager;
+import com.aws.greengrass.clientdevices.auth.session.SessionStore;
 import com.aws.greengrass.clientdevices.auth.util.ResizableLinkedBlockingQueue;
 import com.aws.greengrass.config.Topic;
 import com.aws.greengrass.config.Topics;
@@ -68,6 +74,16 @@ public class ClientDevicesAuthService extends PluginService {
     public static final String AUTHORITIES_TOPIC = "authorities";
     public static final String PERFORMANCE_TOPIC = "performance";
     public static final String MAX_ACTIVE_AUTH_TOKENS_TOPIC = "maxActiveAuthTokens";
+    public static final String SESSION_IDLE_TIMEOUT_SECONDS_TOPIC = "sessionIdleTimeoutSeconds";
+    public static final String SESSION_MAX_LIFETIME_SECONDS_TOPIC = "sessionMaxLifetimeSeconds";
+    public static final String SESSION_REUSE_MAX_AGE_SECONDS_TOPIC = "sessionReuseMaxAgeSeconds";
+    public static final String SIGNED_AUTH_TOKENS_TOPIC = "signedAuthTokens";
+    public static final String PERSIST_SESSIONS_TOPIC = "persistSessions";
+    public static final String CERTIFICATE_CACHE_SIZE_TOPIC = "certificateCacheSize";
+    public static final String CERTIFICATE_CACHE_TTL_SECONDS_TOPIC = "certificateCacheTtlSeconds";
+    public static final String ASSOCIATION_CACHE_SIZE_TOPIC = "associationCacheSize";
+    public static final String ASSOCIATION_CACHE_TTL_SECONDS_TOPIC = "associationCacheTtlSeconds";
+    public static final String ASSOCIATION_NEGATIVE_CACHE_TTL_SECONDS_TOPIC = "associationNegativeCacheTtlSeconds";
     private static final ObjectMapper OBJECT_MAPPER = new ObjectMapper()
             .enable(MapperFeature.ACCEPT_CASE_INSENSITIVE_ENUMS, MapperFeature.ACCEPT_CASE_INSENSITIVE_PROPERTIES);
     private static final RetryUtils.RetryConfig SERVICE_EXCEPTION_RETRY_CONFIG =
@@ -87,6 +103,11 @@ public class ClientDevicesAuthService extends PluginService {
     private final DeviceConfiguration deviceConfiguration;
     private final AuthorizationHandler authorizationHandler;
     private final GreengrassCoreIPCService greengrassCoreIPCService;
+    private final SessionManager sessionManager;
+    private final SessionStore sessionStore;
+    private final SessionConfig sessionConfig;
+    private final CertificateRegistry certificateRegistry;
+    private final IotAuthClient iotAuthClient;
     // Limit the queue size before we start rejecting requests
     private static final int DEFAULT_CLOUD_CALL_QUEUE_SIZE = 100;
     private static final int DEFAULT_THREAD_POOL_SIZE = 1;
@@ -107,6 +128,9 @@ public class ClientDevicesAuthService extends PluginService {
      * @param greengrassCoreIPCService    core IPC service
      * @param mqttSessionFactory          session factory to handling mqtt credentials
      * @param sessionManager              session manager
+     * @param sessionStore                session persistence
+     * @param certificateRegistry         device certificate registry
+     * @param iotAuthClient               IoT auth client
      * @param clientDevicesAuthServiceApi client devices service api handle
      */
     @SuppressWarnings("PMD.ExcessiveParameterList")
@@ -118,6 +142,9 @@ public class ClientDevicesAuthService extends PluginService {
                                     GreengrassCoreIPCService greengrassCoreIPCService,
                                     MqttSessionFactory mqttSessionFactory,
                                     SessionManager sessionManager,
+                                    SessionStore sessionStore,
+                                    CertificateRegistry certificateRegistry,
+                                    IotAuthClient iotAuthClient,
                                     ClientDevicesAuthServiceApi clientDevicesAuthServiceApi) {
         super(topics);
         cloudCallQueueSize = DEFAULT_CLOUD_CALL_QUEUE_SIZE;
@@ -133,9 +160,17 @@ public class ClientDevicesAuthService extends PluginService {
         this.deviceConfiguration = deviceConfiguration;
         this.authorizationHandler = authorizationHandler;
         this.greengrassCoreIPCService = greengrassCoreIPCService;
+        this.sessionManager = sessionManager;
+        this.sessionStore = sessionStore;
+        this.certificateRegistry = certificateRegistry;
+        this.iotAuthClient = iotAuthClient;
         SessionCreator.registerSessionFactory("mqtt", mqttSessionFactory);
         certificateManager.updateCertificatesConfiguration(new CertificatesConfig(this.getConfig()));
-        sessionManager.setSessionConfig(new SessionConfig(this.getConfig()));
+        this.sessionConfig = new SessionConfig(this.getConfig());
+        sessionManager.setSessionConfig(sessionConfig);
+        IotAuthCacheConfig iotAuthCacheConfig = new IotAuthCacheConfig(this.getConfig());
+        certificateRegistry.setCacheConfig(iotAuthCacheConfig);
+        iotAuthClient.setCacheConfig(iotAuthCacheConfig);
     }
 
     private int getValidCloudCallQueueSize(Topics topics) {
@@ -157,6 +192,16 @@ public class ClientDevicesAuthService extends PluginService {
      * |         |---- cloudRequestQueueSize: "..."
      * |         |---- maxConcurrentCloudRequests: "..."
      * |         |---- maxActiveAuthTokens: "..."
+     * |         |---- sessionIdleTimeoutSeconds: "..."
+     * |         |---- sessionMaxLifetimeSeconds: "..."
+     * |         |---- sessionReuseMaxAgeSeconds: "..."
+     * |         |---- signedAuthTokens: "..."
+     * |         |---- persistSessions: "..."
+     * |         |---- certificateCacheSize: "..."
+     * |         |---- certificateCacheTtlSeconds: "..."
+     * |         |---- associationCacheSize: "..."
+     * |         |---- associationCacheTtlSeconds: "..."
+     * |         |---- associationNegativeCacheTtlSeconds: "..."
      * |    |---- deviceGroups:
      * |         |---- definitions : {}
      * |         |---- policies : {}
@@ -198,6 +243,10 @@ public class ClientDevicesAuthService extends PluginService {
                 }
             }
 
+            if (whatHappened != WhatHappened.initialized) {
+                logIotAuthCacheStats();
+            }
+
             if (whatHappened == WhatHappened.initialized || node == null) {
                 updateDeviceGroups(whatHappened, deviceGroupTopics);
                 updateCAType(caTypeTopic);
@@ -216,6 +265,20 @@ public class ClientDevicesAuthService extends PluginService {
     @Override
     protected void startup() throws InterruptedException {
         certificateManager.startMonitors();
+        if (sessionConfig.isPersistSessions()) {
+            try {
+                sessionManager.startPersistence(sessionStore);
+            } catch (IOException e) {
+                // Devices authenticate again, as they would without persistence
+                logger.atWarn().cause(e).log("Unable to persist sessions. Sessions will be lost on restart");
+            }
+        } else {
+            try {
+                sessionManager.discardPersistedSessions(sessionStore);
+            } catch (IOException e) {
+                logger.atWarn().cause(e).log("Unable to delete persisted sessions");
+            }
+        }
         super.startup();
     }
 
@@ -223,6 +286,7 @@ public class ClientDevicesAuthService extends PluginService {
     protected void shutdown() throws InterruptedException {
         super.shutdown();
         certificateManager.stopMonitors();
+        sessionManager.stopPersistence();
     }
 
     @Override
@@ -257,11 +321,27 @@ public class ClientDevicesAuthService extends PluginService {
         return certificateManager;
     }
 
+    // Reported on every configuration change, e.g. to check the effect of changed cache sizes and TTLs
+    private void logIotAuthCacheStats() {
+        logger.atDebug().kv("certificateCacheHits", certificateRegistry.getCacheHitCount())
+                .kv("certificateCacheMisses", certificateRegistry.getCacheMissCount())
+                .kv("associationCacheHits", iotAuthClient.getAssociationCacheHitCount())
+                .kv("associationCacheMisses", iotAuthClient.getAssociationCacheMissCount())
+                .log("IoT auth cache statistics");
+    }
+
     private void updateDeviceGroups(WhatHappened whatHappened, Topics deviceGroupsTopics) {
         try {
-            groupManager.setGroupConfiguration(
-                    OBJECT_MAPPER.convertValue(deviceGroupsTopics.toPOJO(), GroupConfiguration.class));
-        } catch (IllegalArgumentException e) {
+            // Unchanged groups are reused from the current configuration, then the new one is swapped in at once
+            groupManager.setGroupConfiguration(GroupConfigurationConverter.convert(OBJECT_MAPPER,
+                    deviceGroupsTopics.toPOJO(), groupManager.getGroupConfiguration()));
+            CompiledRuleCache ruleCache = CompiledRuleCache.getShared();
+            logger.atDebug().kv("cachedRules", ruleCache.size())
+                    .kv("ruleCacheHits", ruleCache.getHitCount())
+                    .kv("ruleCacheMisses", ruleCache.getMissCount())
+                    .kv("ruleParseTimeMillis", TimeUnit.NANOSECONDS.toMillis(ruleCache.getParseTimeNanos()))
+                    .log("Group configuration updated");
+        } catch (IllegalArgumentException | AuthorizationException e) {
             logger.atError().kv("event", whatHappened)
                     .kv("node", deviceGroupsTopics.getFullName())
                     .setCause(e)
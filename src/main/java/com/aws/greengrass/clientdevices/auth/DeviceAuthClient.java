@@ -7,6 +7,7 @@ package com.aws.greengrass.clientdevices.auth;
 
 import com.aws.greengrass.clientdevices.auth.certificate.CertificateStore;
 import com.aws.greengrass.clientdevices.auth.configuration.GroupManager;
+import com.aws.greengrass.clientdevices.auth.configuration.PermissionIndex;
 import com.aws.greengrass.clientdevices.auth.exception.AuthorizationException;
 import com.aws.greengrass.clientdevices.auth.exception.InvalidSessionException;
 import com.aws.greengrass.clientdevices.auth.iot.Component;
@@ -121,29 +122,103 @@ public class DeviceAuthClient {
      * @throws AuthorizationException if session is invalid
      */
     public boolean canDevicePerform(AuthorizationRequest request) throws AuthorizationException {
-        logger.atDebug()
-                .kv("sessionId", request.getSessionId())
-                .kv("action", request.getOperation())
-                .kv("resource", request.getResource())
-                .log("Processing authorization request");
+        logRequest(request);
 
         // TODO: Remove this workaround
+        // Keep the workaround (ALLOW_ALL_SESSION) for Moquette since it is using the older session management
         if (request.getSessionId().equals(ALLOW_ALL_SESSION)) {
             return true;
         }
 
-        Session session = sessionManager.findSession(request.getSessionId());
-        if (session == null) {
-            throw new InvalidSessionException(
-                    String.format("Invalid session ID (%s)", request.getSessionId()));
-        }
-        // Allow all operations from internal components
-        // Keep the workaround above (ALLOW_ALL_SESSION) for Moquette since it is using the older session management
-        if (session.getSessionAttribute(Component.NAMESPACE, "component") != null) {
+        Session session = findSession(request.getSessionId());
+        if (isInternalComponent(session)) {
             return true;
         }
 
-        return PermissionEvaluationUtils.isAuthorized(request.getOperation(), request.getResource(),
-                groupManager.getApplicablePolicyPermissions(session));
+        // Read the generation before evaluating so that a concurrent configuration update can only
+        // cause a decision to be tagged as older than it is, never newer
+        long generation = groupManager.getConfigurationGeneration();
+        Boolean cachedDecision = session.getAuthorizationDecisionCache()
+                .get(generation, request.getOperation(), request.getResource());
+        if (cachedDecision != null) {
+            return cachedDecision;
+        }
+        return evaluate(session, generation, request, groupManager.getApplicablePermissionIndexes(session));
+    }
+
+    /**
+     * Determine whether each of the requested device operations is allowed.
+     *
+     * <p>Consecutive requests for the same session share a single session lookup and group resolution, so
+     * checking e.g. every topic filter of a SUBSCRIBE costs little more than checking one of them.</p>
+     *
+     * @param requests authorization requests including operation, resource, sessionId, clientId
+     * @return authorization decisions, in the same order as the requests
+     * @throws AuthorizationException if the session of any request is invalid
+     */
+    public List<Boolean> canDevicePerformAll(List<AuthorizationRequest> requests) throws AuthorizationException {
+        long generation = groupManager.getConfigurationGeneration();
+        List<Boolean> decisions = new ArrayList<>(requests.size());
+        String sessionId = null;
+        Session session = null;
+        boolean allowAll = false;
+        List<PermissionIndex> permissionIndexes = null;
+
+        for (AuthorizationRequest request : requests) {
+            logRequest(request);
+            if (!request.getSessionId().equals(sessionId)) {
+                sessionId = request.getSessionId();
+                // TODO: Remove this workaround
+                allowAll = sessionId.equals(ALLOW_ALL_SESSION);
+                session = allowAll ? null : findSession(sessionId);
+                allowAll = allowAll || isInternalComponent(session);
+                permissionIndexes = null;
+            }
+            if (allowAll) {
+                decisions.add(true);
+                continue;
+            }
+
+            Boolean decision = session.getAuthorizationDecisionCache()
+                    .get(generation, request.getOperation(), request.getResource());
+            if (decision == null) {
+                if (permissionIndexes == null) {
+                    permissionIndexes = groupManager.getApplicablePermissionIndexes(session);
+                }
+                decision = evaluate(session, generation, request, permissionIndexes);
+            }
+            decisions.add(decision);
+        }
+        return decisions;
+    }
+
+    private void logRequest(AuthorizationRequest request) {
+        logger.atDebug()
+                .kv("sessionId", request.getSessionId())
+                .kv("action", request.getOperation())
+                .kv("resource", request.getResource())
+                .log("Processing authorization request");
+    }
+
+    private Session findSession(String sessionId) throws InvalidSessionException {
+        Session session = sessionManager.findSession(sessionId);
+        if (session == null) {
+            throw new InvalidSessionException(String.format("Invalid session ID (%s)", sessionId));
+        }
+        return session;
+    }
+
+    // Allow all operations from internal components
+    private boolean isInternalComponent(Session session) {
+        return session.getSessionAttribute(Component.NAMESPACE, "component") != null;
+    }
+
+    private boolean evaluate(Session session, long generation, AuthorizationRequest request,
+                             List<PermissionIndex> permissionIndexes) {
+        boolean decision = PermissionEvaluationUtils.isAuthorized(request.getOperation(), request.getResource(),
+                permissionIndexes, session);
+        session.getAuthorizationDecisionCache()
+                .put(generation, request.getOperation(), request.getResource(), decision);
+        return decision;
     }
 }
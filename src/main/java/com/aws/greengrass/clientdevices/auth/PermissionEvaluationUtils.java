@@ -5,21 +5,17 @@
 
 package com.aws.greengrass.clientdevices.auth;
 
-import com.aws.greengrass.clientdevices.auth.configuration.Permission;
+import com.aws.greengrass.clientdevices.auth.configuration.PermissionIndex;
+import com.aws.greengrass.clientdevices.auth.session.Session;
 import com.aws.greengrass.logging.api.Logger;
 import com.aws.greengrass.logging.impl.LogManager;
 import com.aws.greengrass.util.Utils;
-import lombok.Builder;
-import lombok.Value;
 
-import java.util.Map;
-import java.util.Set;
-import java.util.regex.Matcher;
-import java.util.regex.Pattern;
+import java.util.Arrays;
+import java.util.Collection;
 
 public final class PermissionEvaluationUtils {
     private static final Logger logger = LogManager.getLogger(PermissionEvaluationUtils.class);
-    private static final String ANY_REGEX = "*";
     private static final String SERVICE_PATTERN_STRING = "([a-zA-Z]+)";
     private static final String SERVICE_OPERATION_PATTERN_STRING = "([a-zA-Z0-9-_]+)";
     private static final String SERVICE_RESOURCE_TYPE_PATTERN_STRING = "([a-zA-Z]+)";
@@ -27,60 +23,68 @@ public final class PermissionEvaluationUtils {
     private static final String SERVICE_RESOURCE_NAME_PATTERN_STRING = "([\\w -\\/:-@\\[-\\`{-~]+)";
     private static final String SERVICE_OPERATION_FORMAT = "%s:%s";
     private static final String SERVICE_RESOURCE_FORMAT = "%s:%s:%s";
-    private static final Pattern SERVICE_OPERATION_PATTERN = Pattern.compile(
-            String.format(SERVICE_OPERATION_FORMAT, SERVICE_PATTERN_STRING, SERVICE_OPERATION_PATTERN_STRING));
-    private static final Pattern SERVICE_RESOURCE_PATTERN = Pattern.compile(
-            String.format(SERVICE_RESOURCE_FORMAT, SERVICE_PATTERN_STRING, SERVICE_RESOURCE_TYPE_PATTERN_STRING,
-                    SERVICE_RESOURCE_NAME_PATTERN_STRING), Pattern.UNICODE_CHARACTER_CLASS);
+    // Formats accepted by the parsers below, only used in error messages
+    private static final String SERVICE_OPERATION_PATTERN =
+            String.format(SERVICE_OPERATION_FORMAT, SERVICE_PATTERN_STRING, SERVICE_OPERATION_PATTERN_STRING);
+    private static final String SERVICE_RESOURCE_PATTERN = String.format(SERVICE_RESOURCE_FORMAT,
+            SERVICE_PATTERN_STRING, SERVICE_RESOURCE_TYPE_PATTERN_STRING, SERVICE_RESOURCE_NAME_PATTERN_STRING);
+    private static final char SEPARATOR = ':';
+    private static final TokenPool TOKEN_POOL = new TokenPool();
 
 
     private PermissionEvaluationUtils() {
     }
 
     /**
-     * utility method of authorizing operation to resource.
+     * utility method of authorizing operation to resource using compiled group permissions. A request
+     * explicitly denied by any group is rejected, even if another group allows it.
      *
-     * @param operation             operation in the form of 'service:action'
-     * @param resource              resource in the form of 'service:resourceType:resourceName'
-     * @param groupToPermissionsMap device matching group to permissions map
+     * @param operation         operation in the form of 'service:action'
+     * @param resource          resource in the form of 'service:resourceType:resourceName'
+     * @param permissionIndexes compiled permissions of the device matching groups
      * @return whether operation to resource in authorized
      */
     public static boolean isAuthorized(String operation, String resource,
-                                       Map<String, Set<Permission>> groupToPermissionsMap) {
+                                       Collection<PermissionIndex> permissionIndexes) {
+        return isAuthorized(operation, resource, permissionIndexes, null);
+    }
+
+    /**
+     * utility method of authorizing operation to resource using compiled group permissions, resolving policy
+     * variables such as ${iot:Connection.Thing.ThingName} against the requesting session. A request
+     * explicitly denied by any group is rejected, even if another group allows it.
+     *
+     * @param operation         operation in the form of 'service:action'
+     * @param resource          resource in the form of 'service:resourceType:resourceName'
+     * @param permissionIndexes compiled permissions of the device matching groups
+     * @param session           session of the requesting device, or null if policy variables can't be resolved
+     * @return whether operation to resource in authorized
+     */
+    public static boolean isAuthorized(String operation, String resource,
+                                       Collection<PermissionIndex> permissionIndexes, Session session) {
         Operation op = parseOperation(operation);
         Resource rsc = parseResource(resource);
-        if (!rsc.getService().equals(op.getService())) {
-            throw new IllegalArgumentException(
-                    String.format("Operation %s service is not same as resource %s service", op, rsc));
-
-        }
-        if (groupToPermissionsMap == null || groupToPermissionsMap.isEmpty()) {
+        validateServiceMatches(op, rsc);
+        if (Utils.isEmpty(permissionIndexes)) {
             logger.atDebug().kv("operation", operation).kv("resource", resource)
                     .log("No authorization group matches, " + "deny the request");
             return false;
         }
 
-        for (Map.Entry<String, Set<Permission>> entry : groupToPermissionsMap.entrySet()) {
-            String principal = entry.getKey();
-            Set<Permission> permissions = entry.getValue();
-            if (Utils.isEmpty(permissions)) {
-                continue;
+        // Explicit denies take precedence over allows from any group
+        for (PermissionIndex permissionIndex : permissionIndexes) {
+            if (permissionIndex.hasDenies()
+                    && permissionIndex.denies(op.getService(), op.getAction(), rsc.getResourceType(), resource,
+                    session)) {
+                logger.atDebug().kv("operation", operation).kv("resource", resource).log("Hit deny policy permission");
+                return false;
             }
+        }
 
-            // Find the first matching permission since we don't support 'deny' operation yet.
-            //TODO add support of 'deny' operation
-            Permission permission = permissions.stream().filter(e -> {
-                if (!comparePrincipal(principal, e.getPrincipal())) {
-                    return false;
-                }
-                if (!compareOperation(op, e.getOperation())) {
-                    return false;
-                }
-                return compareResource(rsc, e.getResource());
-            }).findFirst().orElse(null);
-
-            if (permission != null) {
-                logger.atDebug().log("Hit policy with permission {}", permission);
+        for (PermissionIndex permissionIndex : permissionIndexes) {
+            if (permissionIndex.matches(op.getService(), op.getAction(), rsc.getResourceType(), resource,
+                    session)) {
+                logger.atDebug().kv("operation", operation).kv("resource", resource).log("Hit policy permission");
                 return true;
             }
         }
@@ -88,87 +92,248 @@ public final class PermissionEvaluationUtils {
         return false;
     }
 
-    private static boolean comparePrincipal(String requestPrincipal, String policyPrincipal) {
-        if (requestPrincipal.equals(policyPrincipal)) {
-            return true;
+    private static void validateServiceMatches(Operation op, Resource rsc) {
+        if (!rsc.getService().equals(op.getService())) {
+            throw new IllegalArgumentException(
+                    String.format("Operation %s service is not same as resource %s service", op, rsc));
+        }
+    }
+
+    /**
+     * Parse and validate an operation in the form of 'service:action' in a single pass.
+     *
+     * @param operationStr operation
+     * @return parsed operation with pooled service and action tokens
+     * @throws IllegalArgumentException if the operation is malformed
+     */
+    static Operation parseOperation(String operationStr) {
+        if (Utils.isEmpty(operationStr)) {
+            throw new IllegalArgumentException("Operation can't be empty");
         }
 
-        return ANY_REGEX.equals(policyPrincipal);
+        int serviceEnd = scanLetters(operationStr, 0);
+        if (serviceEnd > 0 && serviceEnd < operationStr.length() - 1 && operationStr.charAt(serviceEnd) == SEPARATOR
+                && scanActionChars(operationStr, serviceEnd + 1) == operationStr.length()) {
+            return new Operation(operationStr, TOKEN_POOL.get(operationStr, 0, serviceEnd),
+                    TOKEN_POOL.get(operationStr, serviceEnd + 1, operationStr.length()));
+        }
+        throw new IllegalArgumentException(String.format("Operation %s is not in the form of %s", operationStr,
+                SERVICE_OPERATION_PATTERN));
     }
 
-    private static boolean compareOperation(Operation requestOperation, String policyOperation) {
-        if (requestOperation.toString().equals(policyOperation)) {
-            return true;
+    /**
+     * Parse and validate a resource in the form of 'service:resourceType:resourceName' in a single pass.
+     *
+     * @param resourceStr resource
+     * @return parsed resource with pooled service and resource type tokens
+     * @throws IllegalArgumentException if the resource is malformed
+     */
+    static Resource parseResource(String resourceStr) {
+        if (Utils.isEmpty(resourceStr)) {
+            throw new IllegalArgumentException("Resource can't be empty");
         }
-        if (String.format(SERVICE_OPERATION_FORMAT, requestOperation.getService(), ANY_REGEX).equals(policyOperation)) {
-            return true;
+
+        int serviceEnd = scanLetters(resourceStr, 0);
+        if (serviceEnd > 0 && serviceEnd < resourceStr.length() && resourceStr.charAt(serviceEnd) == SEPARATOR) {
+            int typeEnd = scanLetters(resourceStr, serviceEnd + 1);
+            if (typeEnd > serviceEnd + 1 && typeEnd < resourceStr.length() - 1
+                    && resourceStr.charAt(typeEnd) == SEPARATOR && isValidResourceName(resourceStr, typeEnd + 1)) {
+                return new Resource(resourceStr, TOKEN_POOL.get(resourceStr, 0, serviceEnd),
+                        TOKEN_POOL.get(resourceStr, serviceEnd + 1, typeEnd), typeEnd + 1);
+            }
         }
-        return ANY_REGEX.equals(policyOperation);
+
+        throw new IllegalArgumentException(
+                String.format("Resource %s is not in the form of %s", resourceStr, SERVICE_RESOURCE_PATTERN));
     }
 
-    private static boolean compareResource(Resource requestResource, String policyResource) {
-        if (requestResource.toString().equals(policyResource)) {
-            return true;
+    private static int scanLetters(String str, int start) {
+        int i = start;
+        while (i < str.length() && isAsciiLetter(str.charAt(i))) {
+            i++;
         }
+        return i;
+    }
 
-        if (String.format(SERVICE_RESOURCE_FORMAT, requestResource.getService(), requestResource.getResourceType(),
-                ANY_REGEX).equals(policyResource)) {
-            return true;
+    private static int scanActionChars(String str, int start) {
+        int i = start;
+        while (i < str.length()) {
+            char c = str.charAt(i);
+            if (!isAsciiLetter(c) && !(c >= '0' && c <= '9') && c != '-' && c != '_') {
+                break;
+            }
+            i++;
         }
+        return i;
+    }
 
-        return ANY_REGEX.equals(policyResource);
+    private static boolean isAsciiLetter(char c) {
+        return c >= 'a' && c <= 'z' || c >= 'A' && c <= 'Z';
     }
 
-    private static Operation parseOperation(String operationStr) {
-        if (Utils.isEmpty(operationStr)) {
-            throw new IllegalArgumentException("Operation can't be empty");
+    /**
+     * Resource names may contain printable ASCII characters, space and Unicode word characters.
+     */
+    private static boolean isValidResourceName(String str, int start) {
+        int i = start;
+        while (i < str.length()) {
+            char c = str.charAt(i);
+            if (c >= ' ' && c <= '~') {
+                i++;
+                continue;
+            }
+            int codePoint = str.codePointAt(i);
+            if (!isUnicodeWordCharacter(codePoint)) {
+                return false;
+            }
+            i += Character.charCount(codePoint);
         }
+        return true;
+    }
 
-        Matcher matcher = SERVICE_OPERATION_PATTERN.matcher(operationStr);
-        if (matcher.matches()) {
-            return Operation.builder().service(matcher.group(1)).action(matcher.group(2)).build();
+    // Same character set as \w with Pattern.UNICODE_CHARACTER_CLASS
+    private static boolean isUnicodeWordCharacter(int codePoint) {
+        if (Character.isAlphabetic(codePoint) || Character.isDigit(codePoint)) {
+            return true;
+        }
+        switch (Character.getType(codePoint)) {
+            case Character.NON_SPACING_MARK:
+            case Character.ENCLOSING_MARK:
+            case Character.COMBINING_SPACING_MARK:
+            case Character.CONNECTOR_PUNCTUATION:
+                return true;
+            default:
+                // Join_Control
+                return codePoint == 0x200C || codePoint == 0x200D;
         }
-        throw new IllegalArgumentException(String.format("Operation %s is not in the form of %s", operationStr,
-                SERVICE_OPERATION_PATTERN.pattern()));
     }
 
-    private static Resource parseResource(String resourceStr) {
-        if (Utils.isEmpty(resourceStr)) {
-            throw new IllegalArgumentException("Resource can't be empty");
+    static final class Operation {
+        private final String operation;
+        private final String service;
+        private final String action;
+
+        Operation(String operation, String service, String action) {
+            this.operation = operation;
+            this.service = service;
+            this.action = action;
         }
 
-        Matcher matcher = SERVICE_RESOURCE_PATTERN.matcher(resourceStr);
-        if (matcher.matches()) {
-            return Resource.builder().service(matcher.group(1)).resourceType(matcher.group(2))
-                    .resourceName(matcher.group(3)).build();
+        String getOperation() {
+            return operation;
         }
 
-        throw new IllegalArgumentException(
-                String.format("Resource %s is not in the form of %s", resourceStr, SERVICE_RESOURCE_PATTERN.pattern()));
-    }
+        String getService() {
+            return service;
+        }
 
-    @Value
-    @Builder
-    private static class Operation {
-        String service;
-        String action;
+        String getAction() {
+            return action;
+        }
 
         @Override
         public String toString() {
-            return String.format(SERVICE_OPERATION_FORMAT, service, action);
+            return operation;
         }
     }
 
-    @Value
-    @Builder
-    private static class Resource {
-        String service;
-        String resourceType;
-        String resourceName;
+    static final class Resource {
+        private final String resource;
+        private final String service;
+        private final String resourceType;
+        private final int nameStart;
+
+        Resource(String resource, String service, String resourceType, int nameStart) {
+            this.resource = resource;
+            this.service = service;
+            this.resourceType = resourceType;
+            this.nameStart = nameStart;
+        }
+
+        String getResource() {
+            return resource;
+        }
+
+        String getService() {
+            return service;
+        }
+
+        String getResourceType() {
+            return resourceType;
+        }
+
+        // Index at which the resource name starts within the full resource
+        int getNameStart() {
+            return nameStart;
+        }
+
+        String getResourceName() {
+            return resource.substring(nameStart);
+        }
 
         @Override
         public String toString() {
-            return String.format(SERVICE_RESOURCE_FORMAT, service, resourceType, resourceName);
+            return resource;
+        }
+    }
+
+    /**
+     * Bounded pool of canonical token strings, e.g. 'mqtt' and 'publish'. Looking a token up by its position
+     * in a larger string only allocates the first time the token is seen. The pool is a copy-on-write, open
+     * addressing hash table; once it is half full, further tokens are returned without being pooled.
+     */
+    private static final class TokenPool {
+        private static final int TABLE_SIZE = 512;
+        private static final int MAX_TOKENS = TABLE_SIZE / 2;
+        private volatile String[] table = new String[TABLE_SIZE];
+        private int size;
+
+        String get(String str, int start, int end) {
+            int hash = hash(str, start, end);
+            String token = find(table, str, start, end, hash);
+            if (token != null) {
+                return token;
+            }
+            synchronized (this) {
+                String[] current = table;
+                token = find(current, str, start, end, hash);
+                if (token != null) {
+                    return token;
+                }
+                token = str.substring(start, end);
+                if (size < MAX_TOKENS) {
+                    String[] updated = Arrays.copyOf(current, TABLE_SIZE);
+                    int i = hash;
+                    while (updated[i & (TABLE_SIZE - 1)] != null) {
+                        i++;
+                    }
+                    updated[i & (TABLE_SIZE - 1)] = token;
+                    size++;
+                    table = updated;
+                }
+                return token;
+            }
+        }
+
+        private static String find(String[] table, String str, int start, int end, int hash) {
+            int length = end - start;
+            for (int i = hash; ; i++) {
+                String token = table[i & (TABLE_SIZE - 1)];
+                if (token == null) {
+                    return null;
+                }
+                if (token.length() == length && str.regionMatches(start, token, 0, length)) {
+                    return token;
+                }
+            }
+        }
+
+        private static int hash(String str, int start, int end) {
+            int h = 0;
+            for (int i = start; i < end; i++) {
+                h = 31 * h + str.charAt(i);
+            }
+            return h ^ (h >>> 16);
         }
     }
 }
@@ -12,8 +12,10 @@ import com.aws.greengrass.clientdevices.auth.exception.AuthenticationException;
 import com.aws.greengrass.clientdevices.auth.exception.AuthorizationException;
 import com.aws.greengrass.clientdevices.auth.exception.CertificateGenerationException;
 import com.aws.greengrass.clientdevices.auth.iot.CertificateRegistry;
+import com.aws.greengrass.clientdevices.auth.iot.IotAuthClient;
 import com.aws.greengrass.clientdevices.auth.session.SessionManager;
 
+import java.util.List;
 import java.util.Map;
 import javax.inject.Inject;
 
@@ -22,6 +24,7 @@ public class ClientDevicesAuthServiceApi {
     private final SessionManager sessionManager;
     private final DeviceAuthClient deviceAuthClient;
     private final CertificateManager certificateManager;
+    private final IotAuthClient iotAuthClient;
 
     /**
      * Constructor.
@@ -30,16 +33,19 @@ public class ClientDevicesAuthServiceApi {
      * @param sessionManager      session manager
      * @param deviceAuthClient    device auth client
      * @param certificateManager  certificate manager
+     * @param iotAuthClient       iot auth client
      */
     @Inject
     public ClientDevicesAuthServiceApi(CertificateRegistry certificateRegistry,
                                        SessionManager sessionManager,
                                        DeviceAuthClient deviceAuthClient,
-                                       CertificateManager certificateManager) {
+                                       CertificateManager certificateManager,
+                                       IotAuthClient iotAuthClient) {
         this.certificateRegistry = certificateRegistry;
         this.sessionManager = sessionManager;
         this.deviceAuthClient = deviceAuthClient;
         this.certificateManager = certificateManager;
+        this.iotAuthClient = iotAuthClient;
     }
 
     /**
@@ -78,6 +84,29 @@ public class ClientDevicesAuthServiceApi {
         sessionManager.closeSession(authToken);
     }
 
+    /**
+     * Close every auth session of a thing, e.g. once it has been deleted or detached from its certificate.
+     * Its certificate associations are verified with the cloud again when it next connects.
+     * @param thingName Name of the thing whose sessions are to be closed.
+     * @return number of sessions closed
+     */
+    public int invalidateClientDeviceAuthSessionsForThing(String thingName) {
+        iotAuthClient.invalidateThing(thingName);
+        return sessionManager.invalidateSessionsForThing(thingName);
+    }
+
+    /**
+     * Close every auth session authenticated with a certificate, e.g. once it has been deactivated.
+     * The certificate is verified with the cloud again when a client next connects with it.
+     * @param certificateId IoT certificate ID whose sessions are to be closed.
+     * @return number of sessions closed
+     */
+    public int invalidateClientDeviceAuthSessionsForCertificate(String certificateId) {
+        certificateRegistry.invalidateCertificate(certificateId);
+        iotAuthClient.invalidateCertificate(certificateId);
+        return sessionManager.invalidateSessionsForCertificate(certificateId);
+    }
+
     /**
      * Authorize client action.
      * @param authorizationRequest Authorization request, including auth token, operation, and resource
@@ -89,6 +118,17 @@ public class ClientDevicesAuthServiceApi {
         return deviceAuthClient.canDevicePerform(authorizationRequest);
     }
 
+    /**
+     * Authorize a batch of client actions, e.g. every topic filter of an MQTT SUBSCRIBE.
+     * @param authorizationRequests Authorization requests, each including auth token, operation, and resource
+     * @return whether each client action is allowed, in the same order as the requests
+     * @throws AuthorizationException if any of the auth tokens is invalid
+     */
+    public List<Boolean> authorizeClientDeviceActions(List<AuthorizationRequest> authorizationRequests)
+            throws AuthorizationException {
+        return deviceAuthClient.canDevicePerformAll(authorizationRequests);
+    }
+
     /**
      * Subscribe to certificate updates.
      * @param getCertificateRequest subscription request parameters
@@ -34,6 +34,7 @@ public class AuthorizationPolicyStatement {
     }
 
     public enum Effect {
-        ALLOW
+        ALLOW,
+        DENY
     }
 }
@@ -0,0 +1,22 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTStart;
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import lombok.Value;
+
+import java.util.function.Predicate;
+
+/**
+ * Selection rule parsed, normalized and compiled for evaluation. Compiled rules are shared between group
+ * definitions with the same selection rule, so neither the expression tree nor the predicate may be modified.
+ */
+@Value
+public class CompiledRule {
+    ASTStart expressionTree;
+    Predicate<Session> predicate;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTStart;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ParseException;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.RuleExpression;
+
+import java.io.StringReader;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * Bounded LRU cache from selection rule text to compiled rules.
+ *
+ * <p>Fleets often have many groups with the same selection rule, and every configuration update builds all
+ * group definitions again. Group definitions are compiled through the process-wide {@link #getShared()} cache,
+ * so each distinct rule is parsed once for as long as it stays in use. Rules are keyed by their text with
+ * runs of the whitespace skipped by the grammar collapsed. Rules that fail to parse are not cached.</p>
+ */
+public class CompiledRuleCache {
+    public static final int DEFAULT_CAPACITY = 10_000;
+    private static final CompiledRuleCache SHARED = new CompiledRuleCache(DEFAULT_CAPACITY);
+
+    private final Map<String, CompiledRule> compiledRules;
+    private final LongAdder hitCount = new LongAdder();
+    private final LongAdder missCount = new LongAdder();
+    private final LongAdder parseTimeNanos = new LongAdder();
+
+    /**
+     * Constructor.
+     *
+     * @param capacity maximum number of compiled rules to keep
+     */
+    public CompiledRuleCache(int capacity) {
+        this.compiledRules = Collections.synchronizedMap(new LinkedHashMap<String, CompiledRule>(16, 0.75f, true) {
+            @Override
+            protected boolean removeEldestEntry(Map.Entry<String, CompiledRule> eldest) {
+                return size() > capacity;
+            }
+        });
+    }
+
+    public static CompiledRuleCache getShared() {
+        return SHARED;
+    }
+
+    /**
+     * Get the compiled form of a selection rule, parsing and compiling it if it is not cached.
+     *
+     * @param selectionRule selection rule
+     * @return compiled rule
+     * @throws ParseException if the selection rule is invalid
+     */
+    public CompiledRule compile(String selectionRule) throws ParseException {
+        String key = normalizeRuleText(selectionRule);
+        CompiledRule compiledRule = compiledRules.get(key);
+        if (compiledRule != null) {
+            hitCount.increment();
+            return compiledRule;
+        }
+
+        // Parse without holding the lock. Concurrent misses on the same rule may both parse it
+        missCount.increment();
+        long start = System.nanoTime();
+        try {
+            compiledRule = compileRule(selectionRule);
+        } finally {
+            parseTimeNanos.add(System.nanoTime() - start);
+        }
+        compiledRules.put(key, compiledRule);
+        return compiledRule;
+    }
+
+    private static CompiledRule compileRule(String selectionRule) throws ParseException {
+        ASTStart expressionTree =
+                RuleNormalizer.normalize(new RuleExpression(new StringReader(selectionRule)).Start());
+        return new CompiledRule(expressionTree, RuleCompiler.compile(expressionTree));
+    }
+
+    // Collapse runs of the characters skipped by the grammar
+    static String normalizeRuleText(String selectionRule) {
+        StringBuilder normalized = new StringBuilder(selectionRule.length());
+        boolean pendingSpace = false;
+        for (int i = 0; i < selectionRule.length(); i++) {
+            char c = selectionRule.charAt(i);
+            if (c == ' ' || c == '\r' || c == '\t') {
+                pendingSpace = normalized.length() > 0;
+                continue;
+            }
+            if (pendingSpace) {
+                normalized.append(' ');
+                pendingSpace = false;
+            }
+            normalized.append(c);
+        }
+        return normalized.toString();
+    }
+
+    public int size() {
+        return compiledRules.size();
+    }
+
+    public long getHitCount() {
+        return hitCount.sum();
+    }
+
+    public long getMissCount() {
+        return missCount.sum();
+    }
+
+    /**
+     * Get the total time spent parsing and compiling rules which were not cached.
+     *
+     * @return parse time in nanoseconds
+     */
+    public long getParseTimeNanos() {
+        return parseTimeNanos.sum();
+    }
+}
@@ -29,22 +29,23 @@ public class ExpressionVisitor implements RuleExpressionVisitor {
 
     @Override
     public Object visit(ASTOr node, Object data) {
-        boolean c1 = (boolean) node.jjtGetChild(0).jjtAccept(this, data);
-        boolean c2 = false;
-        if (!c1) {
-            c2 = (boolean) node.jjtGetChild(1).jjtAccept(this, data);
+        // Two children as parsed, any number once normalized
+        for (int i = 0; i < node.jjtGetNumChildren(); i++) {
+            if ((boolean) node.jjtGetChild(i).jjtAccept(this, data)) {
+                return true;
+            }
         }
-        return c1 || c2;
+        return false;
     }
 
     @Override
     public Object visit(ASTAnd node, Object data) {
-        boolean c1 = (boolean) node.jjtGetChild(0).jjtAccept(this, data);
-        boolean c2 = false;
-        if (c1) {
-            c2 = (boolean) node.jjtGetChild(1).jjtAccept(this, data);
+        for (int i = 0; i < node.jjtGetNumChildren(); i++) {
+            if (!(boolean) node.jjtGetChild(i).jjtAccept(this, data)) {
+                return false;
+            }
         }
-        return c1 && c2;
+        return true;
     }
 
     @Override
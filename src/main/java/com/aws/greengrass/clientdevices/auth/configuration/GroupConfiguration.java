@@ -12,18 +12,25 @@ import com.aws.greengrass.util.Utils;
 import com.fasterxml.jackson.databind.annotation.JsonDeserialize;
 import com.fasterxml.jackson.databind.annotation.JsonPOJOBuilder;
 import lombok.Builder;
+import lombok.EqualsAndHashCode;
+import lombok.ToString;
 import lombok.Value;
 
+import java.util.ArrayList;
 import java.util.Collections;
 import java.util.HashMap;
 import java.util.HashSet;
+import java.util.List;
 import java.util.Map;
 import java.util.Set;
+import java.util.TreeSet;
+import java.util.concurrent.atomic.AtomicLong;
 
 @Value
 @JsonDeserialize(builder = GroupConfiguration.GroupConfigurationBuilder.class)
 public class GroupConfiguration {
     private static final Logger logger = LogManager.getLogger(GroupConfiguration.class);
+    private static final AtomicLong GENERATION_COUNTER = new AtomicLong();
 
     ConfigurationFormatVersion formatVersion;
 
@@ -36,20 +43,108 @@ public class GroupConfiguration {
 
     Map<String, Set<Permission>> groupToPermissionsMap;
 
+    // group name to permissions explicitly denied by DENY statements
+    Map<String, Set<Permission>> groupToDenyPermissionsMap;
+
+    // group name to permissions compiled for fast evaluation
+    @EqualsAndHashCode.Exclude
+    @ToString.Exclude
+    Map<String, PermissionIndex> groupToPermissionIndexMap;
+
+    // group names in a fixed order. Group indices, e.g. in session group memberships, refer to this list
+    @EqualsAndHashCode.Exclude
+    @ToString.Exclude
+    List<String> groupNames;
+
+    // compiled permissions, indexed like groupNames
+    @EqualsAndHashCode.Exclude
+    @ToString.Exclude
+    List<PermissionIndex> groupPermissionIndexes;
+
+    // thing name index used to find the groups of a session without evaluating every selection rule
+    @EqualsAndHashCode.Exclude
+    @ToString.Exclude
+    GroupSelectionIndex groupSelectionIndex;
+
+    // unique, increasing identifier used to tag state derived from this configuration
+    @EqualsAndHashCode.Exclude
+    long generation;
+
     @Builder
     GroupConfiguration(ConfigurationFormatVersion formatVersion, Map<String, GroupDefinition> definitions,
                        Map<String, Map<String, AuthorizationPolicyStatement>> policies) throws AuthorizationException {
+        this(formatVersion, definitions, policies, null);
+    }
+
+    private GroupConfiguration(ConfigurationFormatVersion formatVersion, Map<String, GroupDefinition> definitions,
+                               Map<String, Map<String, AuthorizationPolicyStatement>> policies,
+                               GroupConfiguration previous) throws AuthorizationException {
         this.formatVersion = formatVersion == null ? ConfigurationFormatVersion.MAR_05_2021 : formatVersion;
         this.definitions = definitions == null ? Collections.emptyMap() : definitions;
         this.policies = policies == null ? Collections.emptyMap() : policies;
-        this.groupToPermissionsMap = constructGroupToPermissionsMap();
+        Set<String> unchangedGroups = findUnchangedGroups(previous);
+        this.groupToPermissionsMap = constructGroupToPermissionsMap(AuthorizationPolicyStatement.Effect.ALLOW,
+                previous == null ? null : previous.groupToPermissionsMap, unchangedGroups);
+        this.groupToDenyPermissionsMap = constructGroupToPermissionsMap(AuthorizationPolicyStatement.Effect.DENY,
+                previous == null ? null : previous.groupToDenyPermissionsMap, unchangedGroups);
+        this.groupToPermissionIndexMap = constructGroupToPermissionIndexMap(
+                previous == null ? null : previous.groupToPermissionIndexMap, unchangedGroups);
+        this.groupNames = Collections.unmodifiableList(new ArrayList<>(new TreeSet<>(this.definitions.keySet())));
+        List<PermissionIndex> permissionIndexes = new ArrayList<>(groupNames.size());
+        for (String groupName : groupNames) {
+            permissionIndexes.add(groupToPermissionIndexMap.get(groupName));
+        }
+        this.groupPermissionIndexes = Collections.unmodifiableList(permissionIndexes);
+        this.groupSelectionIndex = GroupSelectionIndex.build(groupNames, this.definitions);
+        this.generation = GENERATION_COUNTER.incrementAndGet();
+    }
+
+    /**
+     * Build the configuration replacing a previous one. Permissions of groups whose definition and policy are
+     * unchanged are reused from the previous configuration instead of being rebuilt.
+     *
+     * @param previous      configuration being replaced, may be null
+     * @param formatVersion configuration format version
+     * @param definitions   group name to group definition map
+     * @param policies      policy name to policy map
+     * @return new group configuration
+     * @throws AuthorizationException if a group refers to a policy which does not exist
+     */
+    public static GroupConfiguration update(GroupConfiguration previous, ConfigurationFormatVersion formatVersion,
+                                            Map<String, GroupDefinition> definitions,
+                                            Map<String, Map<String, AuthorizationPolicyStatement>> policies)
+            throws AuthorizationException {
+        return new GroupConfiguration(formatVersion, definitions, policies, previous);
     }
 
     @JsonPOJOBuilder(withPrefix = "")
     public static class GroupConfigurationBuilder {
     }
 
-    private Map<String, Set<Permission>> constructGroupToPermissionsMap() throws AuthorizationException {
+    private Set<String> findUnchangedGroups(GroupConfiguration previous) {
+        if (previous == null) {
+            return Collections.emptySet();
+        }
+        Set<String> unchangedGroups = new HashSet<>();
+        Map<String, Boolean> unchangedPolicies = new HashMap<>();
+        for (Map.Entry<String, GroupDefinition> groupDefinitionEntry : definitions.entrySet()) {
+            GroupDefinition previousDefinition = previous.definitions.get(groupDefinitionEntry.getKey());
+            String policyName = groupDefinitionEntry.getValue().getPolicyName();
+            if (previousDefinition == null || !policyName.equals(previousDefinition.getPolicyName())) {
+                continue;
+            }
+            if (unchangedPolicies.computeIfAbsent(policyName, name -> policies.containsKey(name)
+                    && policies.get(name).equals(previous.policies.get(name)))) {
+                unchangedGroups.add(groupDefinitionEntry.getKey());
+            }
+        }
+        return unchangedGroups;
+    }
+
+    private Map<String, Set<Permission>> constructGroupToPermissionsMap(AuthorizationPolicyStatement.Effect effect,
+                                                                        Map<String, Set<Permission>> previousMap,
+                                                                        Set<String> unchangedGroups)
+            throws AuthorizationException {
         Map<String, Set<Permission>> groupToPermissionsMap = new HashMap<>();
 
         for (Map.Entry<String, GroupDefinition> groupDefinitionEntry : definitions.entrySet()) {
@@ -58,21 +153,39 @@ public class GroupConfiguration {
                 throw new AuthorizationException(
                         String.format("Policies doesn't have policy named %s", groupDefinition.getPolicyName()));
             }
+            if (unchangedGroups.contains(groupDefinitionEntry.getKey())) {
+                groupToPermissionsMap.put(groupDefinitionEntry.getKey(),
+                        previousMap.get(groupDefinitionEntry.getKey()));
+                continue;
+            }
             groupToPermissionsMap.put(groupDefinitionEntry.getKey(),
                     constructGroupPermission(groupDefinitionEntry.getKey(),
-                            policies.get(groupDefinition.getPolicyName())));
+                            policies.get(groupDefinition.getPolicyName()), effect));
         }
         return groupToPermissionsMap;
     }
 
+    private Map<String, PermissionIndex> constructGroupToPermissionIndexMap(Map<String, PermissionIndex> previousMap,
+                                                                            Set<String> unchangedGroups) {
+        Map<String, PermissionIndex> groupToPermissionIndexMap = new HashMap<>();
+        for (Map.Entry<String, Set<Permission>> entry : groupToPermissionsMap.entrySet()) {
+            if (unchangedGroups.contains(entry.getKey())) {
+                groupToPermissionIndexMap.put(entry.getKey(), previousMap.get(entry.getKey()));
+                continue;
+            }
+            groupToPermissionIndexMap.put(entry.getKey(),
+                    PermissionIndex.compile(entry.getValue(), groupToDenyPermissionsMap.get(entry.getKey())));
+        }
+        return Collections.unmodifiableMap(groupToPermissionIndexMap);
+    }
+
     private Set<Permission> constructGroupPermission(String groupName,
-                                                     Map<String, AuthorizationPolicyStatement> policyStatementMap) {
+                                                     Map<String, AuthorizationPolicyStatement> policyStatementMap,
+                                                     AuthorizationPolicyStatement.Effect effect) {
         Set<Permission> permissions = new HashSet<>();
         for (Map.Entry<String, AuthorizationPolicyStatement> statementEntry : policyStatementMap.entrySet()) {
             AuthorizationPolicyStatement statement = statementEntry.getValue();
-            // only accept 'ALLOW' effect for beta launch
-            // TODO add 'DENY' effect support
-            if (statement.getEffect() == AuthorizationPolicyStatement.Effect.ALLOW) {
+            if (statement.getEffect() == effect) {
                 permissions.addAll(convertPolicyStatementToPermission(groupName, statement));
             }
         }
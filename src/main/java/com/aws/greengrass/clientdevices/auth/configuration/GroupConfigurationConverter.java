@@ -0,0 +1,103 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.exception.AuthorizationException;
+import com.fasterxml.jackson.core.type.TypeReference;
+import com.fasterxml.jackson.databind.ObjectMapper;
+
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * Converts the deviceGroups configuration into a {@link GroupConfiguration}, reusing as much as possible of the
+ * configuration it replaces. Group definitions whose selection rule and policy name are unchanged keep their
+ * compiled expression trees, and groups whose definition and policy are unchanged keep their permissions.
+ *
+ * <p>Only the expected 'formatVersion', 'definitions' and 'policies' keys are converted incrementally. Anything
+ * else is converted as a whole, so that invalid configurations are reported exactly as before.</p>
+ */
+public final class GroupConfigurationConverter {
+    static final String FORMAT_VERSION_KEY = "formatVersion";
+    static final String DEFINITIONS_KEY = "definitions";
+    static final String POLICIES_KEY = "policies";
+    static final String SELECTION_RULE_KEY = "selectionRule";
+    static final String POLICY_NAME_KEY = "policyName";
+    private static final Set<String> CONFIGURATION_KEYS =
+            new HashSet<>(Arrays.asList(FORMAT_VERSION_KEY, DEFINITIONS_KEY, POLICIES_KEY));
+    private static final Set<String> DEFINITION_KEYS =
+            new HashSet<>(Arrays.asList(SELECTION_RULE_KEY, POLICY_NAME_KEY));
+    private static final TypeReference<Map<String, GroupDefinition>> DEFINITIONS_TYPE =
+            new TypeReference<Map<String, GroupDefinition>>() {
+            };
+    private static final TypeReference<Map<String, Map<String, AuthorizationPolicyStatement>>> POLICIES_TYPE =
+            new TypeReference<Map<String, Map<String, AuthorizationPolicyStatement>>>() {
+            };
+
+    private GroupConfigurationConverter() {
+    }
+
+    /**
+     * Convert the deviceGroups configuration.
+     *
+     * @param mapper       object mapper used to convert changed parts of the configuration
+     * @param deviceGroups deviceGroups configuration, as returned by Topics.toPOJO()
+     * @param previous     configuration being replaced, may be null
+     * @return new group configuration
+     * @throws IllegalArgumentException if the configuration cannot be parsed
+     * @throws AuthorizationException   if a group refers to a policy which does not exist
+     */
+    @SuppressWarnings("unchecked")
+    public static GroupConfiguration convert(ObjectMapper mapper, Map<String, Object> deviceGroups,
+                                             GroupConfiguration previous) throws AuthorizationException {
+        Object definitions = deviceGroups.get(DEFINITIONS_KEY);
+        Object policies = deviceGroups.get(POLICIES_KEY);
+        if (previous == null || !CONFIGURATION_KEYS.containsAll(deviceGroups.keySet())
+                || definitions != null && !(definitions instanceof Map)) {
+            return mapper.convertValue(deviceGroups, GroupConfiguration.class);
+        }
+
+        return GroupConfiguration.update(previous,
+                mapper.convertValue(deviceGroups.get(FORMAT_VERSION_KEY), ConfigurationFormatVersion.class),
+                convertDefinitions(mapper, (Map<String, Object>) definitions, previous.getDefinitions()),
+                mapper.convertValue(policies, POLICIES_TYPE));
+    }
+
+    private static Map<String, GroupDefinition> convertDefinitions(ObjectMapper mapper,
+                                                                   Map<String, Object> definitions,
+                                                                   Map<String, GroupDefinition> previousDefinitions) {
+        if (definitions == null) {
+            return null;
+        }
+        Map<String, GroupDefinition> groupDefinitions = new HashMap<>();
+        Map<String, Object> changedDefinitions = new HashMap<>();
+        for (Map.Entry<String, Object> entry : definitions.entrySet()) {
+            GroupDefinition previousDefinition = previousDefinitions.get(entry.getKey());
+            if (previousDefinition != null && isSameDefinition(entry.getValue(), previousDefinition)) {
+                groupDefinitions.put(entry.getKey(), previousDefinition);
+            } else {
+                changedDefinitions.put(entry.getKey(), entry.getValue());
+            }
+        }
+        if (!changedDefinitions.isEmpty()) {
+            groupDefinitions.putAll(mapper.convertValue(changedDefinitions, DEFINITIONS_TYPE));
+        }
+        return groupDefinitions;
+    }
+
+    private static boolean isSameDefinition(Object definition, GroupDefinition previousDefinition) {
+        if (!(definition instanceof Map)) {
+            return false;
+        }
+        Map<?, ?> fields = (Map<?, ?>) definition;
+        return DEFINITION_KEYS.equals(fields.keySet())
+                && previousDefinition.getSelectionRule().equals(fields.get(SELECTION_RULE_KEY))
+                && previousDefinition.getPolicyName().equals(fields.get(POLICY_NAME_KEY));
+    }
+}
@@ -7,27 +7,40 @@ package com.aws.greengrass.clientdevices.auth.configuration;
 
 import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTStart;
 import com.aws.greengrass.clientdevices.auth.configuration.parser.ParseException;
-import com.aws.greengrass.clientdevices.auth.configuration.parser.RuleExpression;
 import com.aws.greengrass.clientdevices.auth.session.Session;
 import com.fasterxml.jackson.databind.annotation.JsonDeserialize;
 import com.fasterxml.jackson.databind.annotation.JsonPOJOBuilder;
 import lombok.Builder;
+import lombok.EqualsAndHashCode;
 import lombok.NonNull;
+import lombok.ToString;
 import lombok.Value;
 
-import java.io.StringReader;
+import java.util.function.Predicate;
 
 @Value
 @JsonDeserialize(builder = GroupDefinition.GroupDefinitionBuilder.class)
 public class GroupDefinition {
 
-    ASTStart expressionTree;
+    String selectionRule;
     String policyName;
 
+    // normalized tree compiled from selectionRule, so definitions are compared by their rule text
+    @EqualsAndHashCode.Exclude
+    @ToString.Exclude
+    ASTStart expressionTree;
+
+    // expressionTree compiled for evaluation
+    @EqualsAndHashCode.Exclude
+    @ToString.Exclude
+    Predicate<Session> rule;
 
     @Builder
     GroupDefinition(@NonNull String selectionRule, @NonNull String policyName) throws ParseException {
-        this.expressionTree = new RuleExpression(new StringReader(selectionRule)).Start();
+        this.selectionRule = selectionRule;
+        CompiledRule compiledRule = CompiledRuleCache.getShared().compile(selectionRule);
+        this.expressionTree = compiledRule.getExpressionTree();
+        this.rule = compiledRule.getPredicate();
         this.policyName = policyName;
     }
 
@@ -42,7 +55,6 @@ public class GroupDefinition {
      * @return true if the client device belongs to the group
      */
     public boolean containsClientDevice(Session session) {
-        ExpressionVisitor visitor = new ExpressionVisitor();
-        return (boolean) visitor.visit(expressionTree, session);
+        return rule.test(session);
     }
 }
@@ -5,14 +5,13 @@
 
 package com.aws.greengrass.clientdevices.auth.configuration;
 
+import com.aws.greengrass.clientdevices.auth.session.GroupMembership;
 import com.aws.greengrass.clientdevices.auth.session.Session;
 
+import java.util.AbstractList;
 import java.util.Collections;
-import java.util.HashSet;
-import java.util.Map;
-import java.util.Set;
+import java.util.List;
 import java.util.concurrent.atomic.AtomicReference;
-import java.util.stream.Collectors;
 
 /**
  * Singleton manager class for managing device group roles and retrieving permissions associated
@@ -26,32 +25,68 @@ public class GroupManager {
         groupConfigurationRef.set(groupConfiguration);
     }
 
+    public GroupConfiguration getGroupConfiguration() {
+        return groupConfigurationRef.get();
+    }
+
+    /**
+     * Get the generation of the current group configuration. Generations increase every time a new
+     * configuration is installed, so state derived from an older configuration can be detected and discarded.
+     *
+     * @return current configuration generation, or 0 if no configuration has been set
+     */
+    public long getConfigurationGeneration() {
+        GroupConfiguration config = groupConfigurationRef.get();
+        return config == null ? 0 : config.getGeneration();
+    }
+
     /**
-     * find applicable policy permissions to evaluate for the given device request.
+     * find compiled permission indexes of the device groups the given session belongs to.
      *
      * @param session session used to retrieve cached device attributes
-     * @return Map of group name to applicable permission
+     * @return permission indexes of the matching groups
      */
-    public Map<String, Set<Permission>> getApplicablePolicyPermissions(Session session) {
+    public List<PermissionIndex> getApplicablePermissionIndexes(Session session) {
         GroupConfiguration config = groupConfigurationRef.get();
         if (config == null) {
-            return Collections.emptyMap();
+            return Collections.emptyList();
         }
-        Set<String> matchingGroups = findMatchingGroups(config.getDefinitions(), session);
-        return matchingGroups.stream()
-                .collect(Collectors.toMap(group -> group, group -> config.getGroupToPermissionsMap().get(group)));
+        return new MatchingPermissionIndexes(config.getGroupPermissionIndexes(), getGroupMembership(config, session));
     }
 
-    private Set<String> findMatchingGroups(Map<String, GroupDefinition> groupDefinitionMap, Session session) {
-        Set<String> matchingGroups = new HashSet<>();
+    /**
+     * Group membership only depends on session attributes and the group configuration, so it is computed
+     * once per session and configuration generation, and then reused.
+     */
+    private GroupMembership getGroupMembership(GroupConfiguration config, Session session) {
+        GroupMembership membership = session.getGroupMembership();
+        if (membership != null && membership.getGeneration() == config.getGeneration()) {
+            return membership;
+        }
+        membership = new GroupMembership(config.getGeneration(),
+                config.getGroupSelectionIndex().findMatchingGroups(session));
+        session.setGroupMembership(membership);
+        return membership;
+    }
 
-        for (String groupName : groupDefinitionMap.keySet()) {
-            GroupDefinition group = groupDefinitionMap.get(groupName);
-            if (group.containsClientDevice(session)) {
-                matchingGroups.add(groupName);
-            }
+    private static final class MatchingPermissionIndexes extends AbstractList<PermissionIndex> {
+        private final List<PermissionIndex> groupPermissionIndexes;
+        private final GroupMembership membership;
+
+        MatchingPermissionIndexes(List<PermissionIndex> groupPermissionIndexes, GroupMembership membership) {
+            super();
+            this.groupPermissionIndexes = groupPermissionIndexes;
+            this.membership = membership;
+        }
+
+        @Override
+        public PermissionIndex get(int index) {
+            return groupPermissionIndexes.get(membership.getGroupIndex(index));
         }
 
-        return matchingGroups;
+        @Override
+        public int size() {
+            return membership.size();
+        }
     }
 }
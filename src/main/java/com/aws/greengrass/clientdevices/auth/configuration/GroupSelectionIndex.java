@@ -0,0 +1,181 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTOr;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTThing;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.Node;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import com.aws.greengrass.clientdevices.auth.session.attribute.DeviceAttribute;
+import com.aws.greengrass.clientdevices.auth.session.attribute.GlobPattern;
+import com.aws.greengrass.clientdevices.auth.session.attribute.WildcardSuffixAttribute;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.BitSet;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Inverted index from thing names to the device groups whose selection rules match them.
+ *
+ * <p>Selection rules which are disjunctions of {@code thingName} terms are indexed: exact thing names in a
+ * hash map, wildcard prefixes such as {@code prefix*} in a {@link PrefixTrie}, and other glob terms such as
+ * {@code site-*-sensor-*} as compiled {@link GlobPattern}s. Any other rule is kept in a fallback list and
+ * evaluated against the session as before. Looking up the groups of a session therefore costs roughly the
+ * length of its thing name plus the number of glob terms and fallback groups.</p>
+ */
+public final class GroupSelectionIndex {
+    private static final int[] NO_GROUPS = new int[0];
+
+    private final Map<String, int[]> exactThingNames;
+    private final PrefixTrie thingNamePrefixes;
+    private final GlobPattern[] thingNameGlobs;
+    private final int[] thingNameGlobGroups;
+    private final int[] fallbackGroups;
+    private final GroupDefinition[] fallbackDefinitions;
+    private final GroupDefinition[] allDefinitions;
+
+    private GroupSelectionIndex(Map<String, int[]> exactThingNames, PrefixTrie thingNamePrefixes,
+                                GlobPattern[] thingNameGlobs, int[] thingNameGlobGroups,
+                                int[] fallbackGroups, GroupDefinition[] fallbackDefinitions,
+                                GroupDefinition... allDefinitions) {
+        this.exactThingNames = exactThingNames;
+        this.thingNamePrefixes = thingNamePrefixes;
+        this.thingNameGlobs = thingNameGlobs;
+        this.thingNameGlobGroups = thingNameGlobGroups;
+        this.fallbackGroups = fallbackGroups;
+        this.fallbackDefinitions = fallbackDefinitions;
+        this.allDefinitions = allDefinitions;
+    }
+
+    /**
+     * Build an index over the given groups.
+     *
+     * @param groupNames  group names, in group index order
+     * @param definitions group name to group definition map
+     * @return group selection index
+     */
+    public static GroupSelectionIndex build(List<String> groupNames, Map<String, GroupDefinition> definitions) {
+        Map<String, int[]> exactThingNames = new HashMap<>();
+        PrefixTrie thingNamePrefixes = new PrefixTrie();
+        List<GlobPattern> globPatterns = new ArrayList<>();
+        List<Integer> globGroups = new ArrayList<>();
+        List<Integer> fallbackGroups = new ArrayList<>();
+        GroupDefinition[] allDefinitions = new GroupDefinition[groupNames.size()];
+
+        for (int i = 0; i < groupNames.size(); i++) {
+            GroupDefinition definition = definitions.get(groupNames.get(i));
+            allDefinitions[i] = definition;
+            List<String> thingNameTerms = new ArrayList<>();
+            if (!collectThingNameTerms(definition.getExpressionTree().jjtGetChild(0), thingNameTerms)) {
+                fallbackGroups.add(i);
+                continue;
+            }
+            for (String term : thingNameTerms) {
+                GlobPattern pattern = GlobPattern.compile(term);
+                if (pattern.isLiteral()) {
+                    int[] groups = exactThingNames.getOrDefault(term, NO_GROUPS);
+                    if (groups.length == 0 || groups[groups.length - 1] != i) {
+                        groups = Arrays.copyOf(groups, groups.length + 1);
+                        groups[groups.length - 1] = i;
+                        exactThingNames.put(term, groups);
+                    }
+                } else if (pattern.isPrefix()) {
+                    thingNamePrefixes.add(pattern.getPrefix(), i);
+                } else {
+                    globPatterns.add(pattern);
+                    globGroups.add(i);
+                }
+            }
+        }
+
+        int[] fallbackIndices = new int[fallbackGroups.size()];
+        GroupDefinition[] fallbackDefinitions = new GroupDefinition[fallbackGroups.size()];
+        for (int i = 0; i < fallbackIndices.length; i++) {
+            fallbackIndices[i] = fallbackGroups.get(i);
+            fallbackDefinitions[i] = allDefinitions[fallbackIndices[i]];
+        }
+        return new GroupSelectionIndex(exactThingNames, thingNamePrefixes,
+                globPatterns.toArray(new GlobPattern[0]), globGroups.stream().mapToInt(Integer::intValue).toArray(),
+                fallbackIndices, fallbackDefinitions, allDefinitions);
+    }
+
+    /**
+     * Collect the thing name terms of a rule made only of OR and thingName nodes.
+     *
+     * @return false if the rule contains anything else and cannot be indexed
+     */
+    private static boolean collectThingNameTerms(Node node, List<String> terms) {
+        if (node instanceof ASTThing) {
+            terms.add((String) ((ASTThing) node).jjtGetValue());
+            return true;
+        }
+        if (node instanceof ASTOr) {
+            for (int i = 0; i < node.jjtGetNumChildren(); i++) {
+                if (!collectThingNameTerms(node.jjtGetChild(i), terms)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Find the groups the given session belongs to.
+     *
+     * @param session session representing the client device
+     * @return indices of the matching groups, in ascending order
+     */
+    public int[] findMatchingGroups(Session session) {
+        DeviceAttribute thingName = session.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE);
+        if (thingName != null && !(thingName instanceof WildcardSuffixAttribute)) {
+            // Indexed terms assume wildcard suffix semantics, so evaluate every rule for anything else
+            return evaluateAll(session);
+        }
+
+        BitSet matches = new BitSet(allDefinitions.length);
+        if (thingName != null) {
+            String value = ((WildcardSuffixAttribute) thingName).getValue();
+            int[] exactGroups = exactThingNames.get(value);
+            if (exactGroups != null) {
+                for (int group : exactGroups) {
+                    matches.set(group);
+                }
+            }
+            thingNamePrefixes.forEachPrefixOf(value, matches::set);
+            for (int i = 0; i < thingNameGlobs.length; i++) {
+                if (!matches.get(thingNameGlobGroups[i]) && thingName.matches(thingNameGlobs[i])) {
+                    matches.set(thingNameGlobGroups[i]);
+                }
+            }
+        }
+        for (int i = 0; i < fallbackDefinitions.length; i++) {
+            if (fallbackDefinitions[i].containsClientDevice(session)) {
+                matches.set(fallbackGroups[i]);
+            }
+        }
+        return matches.stream().toArray();
+    }
+
+    private int[] evaluateAll(Session session) {
+        int[] matchingGroups = new int[allDefinitions.length];
+        int count = 0;
+        for (int i = 0; i < allDefinitions.length; i++) {
+            if (allDefinitions[i].containsClientDevice(session)) {
+                matchingGroups[count++] = i;
+            }
+        }
+        return Arrays.copyOf(matchingGroups, count);
+    }
+
+    public int getFallbackGroupCount() {
+        return fallbackGroups.length;
+    }
+}
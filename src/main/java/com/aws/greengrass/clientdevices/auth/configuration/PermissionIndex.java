@@ -0,0 +1,408 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.session.Session;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * Immutable, pre-compiled view of a device group's permissions.
+ *
+ * <p>Permissions are bucketed by service and action so that a single authorization decision
+ * costs a handful of hash lookups instead of a scan over every permission of the group.
+ * Operations of the form 'service:*' are stored under the '*' action of their service, and the
+ * '*' operation has its own bucket. Each bucket separately tracks exact resources,
+ * 'service:type:*' resources and the '*' resource. MQTT topic and topic filter resources containing
+ * '+' or '#' wildcards are additionally stored in a {@link TopicFilterTrie} per resource type.
+ * Resources containing policy variables are compiled into {@link ResourceTemplate}s, which are stored in a
+ * character trie of their literal prefixes so that a request is only compared with templates it can match.
+ * Permissions from ALLOW and DENY statements are compiled into separate, identically structured indexes. An
+ * allowed topic filter must cover every topic of a requested filter, while a denied one only has to overlap it,
+ * so the deny index stores every MQTT topic and topic filter resource in its tries, with or without
+ * wildcards.</p>
+ */
+public final class PermissionIndex {
+    public static final PermissionIndex EMPTY = new PermissionIndex(OperationIndex.EMPTY, OperationIndex.EMPTY);
+    private static final String ANY = "*";
+    private static final String WILDCARD_SUFFIX = ":*";
+    private static final char SEPARATOR = ':';
+    private static final String MQTT_SERVICE = "mqtt";
+    private static final String MQTT_TOPIC_RESOURCE_TYPE = "topic";
+    private static final String MQTT_TOPIC_FILTER_RESOURCE_TYPE = "topicfilter";
+
+    private final OperationIndex allowIndex;
+    private final OperationIndex denyIndex;
+
+    private PermissionIndex(OperationIndex allowIndex, OperationIndex denyIndex) {
+        this.allowIndex = allowIndex;
+        this.denyIndex = denyIndex;
+    }
+
+    /**
+     * Compile a set of allowed permissions into an index.
+     *
+     * @param permissions permissions granted to a single device group
+     * @return permission index
+     */
+    public static PermissionIndex compile(Collection<Permission> permissions) {
+        return compile(permissions, Collections.emptySet());
+    }
+
+    /**
+     * Compile sets of allowed and denied permissions into an index.
+     *
+     * <p>Permissions whose operation is not in the form of 'service:action', 'service:*' or '*' can never
+     * match a request and are dropped.</p>
+     *
+     * @param allowPermissions permissions granted to a single device group
+     * @param denyPermissions  permissions explicitly denied to the same device group
+     * @return permission index
+     */
+    public static PermissionIndex compile(Collection<Permission> allowPermissions,
+                                          Collection<Permission> denyPermissions) {
+        OperationIndex allowIndex = OperationIndex.compile(allowPermissions, false);
+        OperationIndex denyIndex = OperationIndex.compile(denyPermissions, true);
+        if (allowIndex == OperationIndex.EMPTY && denyIndex == OperationIndex.EMPTY) {
+            return EMPTY;
+        }
+        return new PermissionIndex(allowIndex, denyIndex);
+    }
+
+    /**
+     * Check whether any permission in this index grants the requested operation on the requested resource.
+     * Denied permissions are not taken into account, see {@link #denies(String, String, String, String)}.
+     *
+     * @param service      requested service, e.g. 'mqtt'
+     * @param action       requested action, e.g. 'publish'
+     * @param resourceType requested resource type, e.g. 'topic'
+     * @param resource     full requested resource in the form of 'service:resourceType:resourceName'
+     * @return true if the operation is granted
+     */
+    public boolean matches(String service, String action, String resourceType, String resource) {
+        return matches(service, action, resourceType, resource, null);
+    }
+
+    /**
+     * Check whether any permission in this index grants the requested operation on the requested resource,
+     * resolving policy variables against the given session.
+     *
+     * @param service      requested service, e.g. 'mqtt'
+     * @param action       requested action, e.g. 'publish'
+     * @param resourceType requested resource type, e.g. 'topic'
+     * @param resource     full requested resource in the form of 'service:resourceType:resourceName'
+     * @param session      session of the requesting device, or null to never match resources with variables
+     * @return true if the operation is granted
+     */
+    public boolean matches(String service, String action, String resourceType, String resource,
+                           Session session) {
+        return allowIndex.matches(service, action, resourceType, resource, session);
+    }
+
+    /**
+     * Check whether any permission in this index explicitly denies the requested operation on the requested
+     * resource. A requested MQTT topic filter is denied if it matches any topic of a denied topic filter.
+     *
+     * @param service      requested service, e.g. 'mqtt'
+     * @param action       requested action, e.g. 'publish'
+     * @param resourceType requested resource type, e.g. 'topic'
+     * @param resource     full requested resource in the form of 'service:resourceType:resourceName'
+     * @return true if the operation is denied
+     */
+    public boolean denies(String service, String action, String resourceType, String resource) {
+        return denies(service, action, resourceType, resource, null);
+    }
+
+    /**
+     * Check whether any permission in this index explicitly denies the requested operation on the requested
+     * resource, resolving policy variables against the given session.
+     *
+     * @param service      requested service, e.g. 'mqtt'
+     * @param action       requested action, e.g. 'publish'
+     * @param resourceType requested resource type, e.g. 'topic'
+     * @param resource     full requested resource in the form of 'service:resourceType:resourceName'
+     * @param session      session of the requesting device, or null to never match resources with variables
+     * @return true if the operation is denied
+     */
+    public boolean denies(String service, String action, String resourceType, String resource, Session session) {
+        return denyIndex != OperationIndex.EMPTY
+                && denyIndex.matches(service, action, resourceType, resource, session);
+    }
+
+    public boolean hasDenies() {
+        return denyIndex != OperationIndex.EMPTY;
+    }
+
+    private static final class OperationIndex {
+        private static final OperationIndex EMPTY = new OperationIndex(Collections.emptyMap(), ResourceIndex.EMPTY);
+
+        // service -> action -> resources. 'service:*' operations are stored under the '*' action
+        private final Map<String, Map<String, ResourceIndex>> serviceActionIndex;
+        // resources matched through the '*' operation
+        private final ResourceIndex anyOperationIndex;
+
+        private OperationIndex(Map<String, Map<String, ResourceIndex>> serviceActionIndex,
+                               ResourceIndex anyOperationIndex) {
+            this.serviceActionIndex = serviceActionIndex;
+            this.anyOperationIndex = anyOperationIndex;
+        }
+
+        static OperationIndex compile(Collection<Permission> permissions, boolean overlap) {
+            if (permissions == null || permissions.isEmpty()) {
+                return EMPTY;
+            }
+
+            Map<String, Map<String, ResourceIndex.Builder>> serviceActionBuilders = new HashMap<>();
+            ResourceIndex.Builder anyOperationBuilder = new ResourceIndex.Builder(overlap);
+            for (Permission permission : permissions) {
+                String operation = permission.getOperation();
+                if (ANY.equals(operation)) {
+                    anyOperationBuilder.add(permission.getResource());
+                    continue;
+                }
+                int separator = operation.indexOf(SEPARATOR);
+                if (separator <= 0 || separator == operation.length() - 1) {
+                    continue;
+                }
+                serviceActionBuilders.computeIfAbsent(operation.substring(0, separator), k -> new HashMap<>())
+                        .computeIfAbsent(operation.substring(separator + 1), k -> new ResourceIndex.Builder(overlap))
+                        .add(permission.getResource());
+            }
+
+            Map<String, Map<String, ResourceIndex>> serviceActionIndex = new HashMap<>();
+            for (Map.Entry<String, Map<String, ResourceIndex.Builder>> serviceEntry
+                    : serviceActionBuilders.entrySet()) {
+                Map<String, ResourceIndex> actionIndex = new HashMap<>();
+                for (Map.Entry<String, ResourceIndex.Builder> actionEntry : serviceEntry.getValue().entrySet()) {
+                    actionIndex.put(actionEntry.getKey(), actionEntry.getValue().build());
+                }
+                serviceActionIndex.put(serviceEntry.getKey(), Collections.unmodifiableMap(actionIndex));
+            }
+            ResourceIndex anyOperationIndex = anyOperationBuilder.build();
+            if (serviceActionIndex.isEmpty() && anyOperationIndex == ResourceIndex.EMPTY) {
+                return EMPTY;
+            }
+            return new OperationIndex(Collections.unmodifiableMap(serviceActionIndex), anyOperationIndex);
+        }
+
+        boolean matches(String service, String action, String resourceType, String resource, Session session) {
+            if (anyOperationIndex.matches(service, resourceType, resource, session)) {
+                return true;
+            }
+            Map<String, ResourceIndex> actionIndex = serviceActionIndex.get(service);
+            if (actionIndex == null) {
+                return false;
+            }
+            ResourceIndex resourceIndex = actionIndex.get(action);
+            if (resourceIndex != null && resourceIndex.matches(service, resourceType, resource, session)) {
+                return true;
+            }
+            resourceIndex = actionIndex.get(ANY);
+            return resourceIndex != null && resourceIndex.matches(service, resourceType, resource, session);
+        }
+    }
+
+    private static final class ResourceIndex {
+        private static final ResourceIndex EMPTY =
+                new ResourceIndex(false, false, Collections.emptySet(), Collections.emptyMap(),
+                        Collections.emptyMap(), new ResourceTemplate[0]);
+
+        // true to match requested topic filters overlapping a stored filter, rather than covered by one
+        private final boolean overlap;
+        private final boolean anyResource;
+        // full 'service:type:name' resources
+        private final Set<String> exactResources;
+        // service -> resource types granted through 'service:type:*'
+        private final Map<String, Set<String>> wildcardResourceTypes;
+        // MQTT resource type -> topic filters containing wildcards, or all topic filters if overlapping
+        private final Map<String, TopicFilterTrie> mqttTopicFilters;
+        // resources containing policy variables
+        private final ResourceTemplate[] templates;
+        // templates keyed by their literal prefix
+        private final PrefixNode templatePrefixes;
+
+        private ResourceIndex(boolean overlap, boolean anyResource, Set<String> exactResources,
+                              Map<String, Set<String>> wildcardResourceTypes,
+                              Map<String, TopicFilterTrie> mqttTopicFilters, ResourceTemplate... templates) {
+            this.overlap = overlap;
+            this.anyResource = anyResource;
+            this.exactResources = exactResources;
+            this.wildcardResourceTypes = wildcardResourceTypes;
+            this.mqttTopicFilters = mqttTopicFilters;
+            this.templates = templates;
+            PrefixNode root = new PrefixNode();
+            for (ResourceTemplate template : templates) {
+                root.add(template.getLiteralPrefix(), template);
+            }
+            this.templatePrefixes = root;
+        }
+
+        boolean matches(String service, String resourceType, String resource, Session session) {
+            if (anyResource || exactResources.contains(resource)) {
+                return true;
+            }
+            Set<String> resourceTypes = wildcardResourceTypes.get(service);
+            if (resourceTypes != null && resourceTypes.contains(resourceType)) {
+                return true;
+            }
+            if (templates.length > 0 && matchesTemplate(resource, session)) {
+                return true;
+            }
+            if (mqttTopicFilters.isEmpty() || !MQTT_SERVICE.equals(service)) {
+                return false;
+            }
+            TopicFilterTrie topicFilters = mqttTopicFilters.get(resourceType);
+            if (topicFilters == null) {
+                return false;
+            }
+            int nameStart = service.length() + resourceType.length() + 2;
+            return overlap ? topicFilters.overlapsAny(resource, nameStart)
+                    : topicFilters.coversAny(resource, nameStart);
+        }
+
+        private boolean matchesTemplate(String resource, Session session) {
+            if (session == null) {
+                return false;
+            }
+            // A requested filter with wildcards can overlap templates whose prefix it does not start with
+            if (overlap && TopicFilterTrie.hasWildcards(resource)) {
+                for (ResourceTemplate template : templates) {
+                    if (template.overlaps(resource, session)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            PrefixNode node = templatePrefixes;
+            for (int i = 0; node != null; i++) {
+                for (ResourceTemplate template : node.templates) {
+                    if (overlap ? template.overlaps(resource, session) : template.matches(resource, session)) {
+                        return true;
+                    }
+                }
+                node = i < resource.length() ? node.child(resource.charAt(i)) : null;
+            }
+            return false;
+        }
+
+        /**
+         * Node of a character trie, holding the templates whose literal prefix ends at this node.
+         */
+        private static final class PrefixNode {
+            // sorted characters of the children, and the children in the same order
+            private char[] keys = new char[0];
+            private PrefixNode[] children = new PrefixNode[0];
+            private ResourceTemplate[] templates = new ResourceTemplate[0];
+
+            void add(String prefix, ResourceTemplate template) {
+                PrefixNode node = this;
+                for (int i = 0; i < prefix.length(); i++) {
+                    char c = prefix.charAt(i);
+                    int index = Arrays.binarySearch(node.keys, c);
+                    if (index < 0) {
+                        index = -index - 1;
+                        node.keys = insert(node.keys, index, c);
+                        PrefixNode[] grown = Arrays.copyOf(node.children, node.children.length + 1);
+                        System.arraycopy(grown, index, grown, index + 1, grown.length - index - 1);
+                        grown[index] = new PrefixNode();
+                        node.children = grown;
+                    }
+                    node = node.children[index];
+                }
+                node.templates = Arrays.copyOf(node.templates, node.templates.length + 1);
+                node.templates[node.templates.length - 1] = template;
+            }
+
+            PrefixNode child(char c) {
+                int index = Arrays.binarySearch(keys, c);
+                return index < 0 ? null : children[index];
+            }
+
+            private static char[] insert(char[] sorted, int index, char c) {
+                char[] updated = new char[sorted.length + 1];
+                System.arraycopy(sorted, 0, updated, 0, index);
+                updated[index] = c;
+                System.arraycopy(sorted, index, updated, index + 1, sorted.length - index);
+                return updated;
+            }
+        }
+
+        private static final class Builder {
+            private final boolean overlap;
+            private boolean anyResource;
+            private final Set<String> exactResources = new HashSet<>();
+            private final Map<String, Set<String>> wildcardResourceTypes = new HashMap<>();
+            private final Map<String, TopicFilterTrie> mqttTopicFilters = new HashMap<>();
+            private final List<ResourceTemplate> templates = new ArrayList<>();
+
+            Builder(boolean overlap) {
+                this.overlap = overlap;
+            }
+
+            void add(String resource) {
+                if (ANY.equals(resource)) {
+                    anyResource = true;
+                    return;
+                }
+                ResourceTemplate template = ResourceTemplate.compile(resource);
+                if (template != null) {
+                    templates.add(template);
+                    return;
+                }
+                // Names may legitimately contain ':' and '*', so the exact form is always kept
+                exactResources.add(resource);
+                if (resource.endsWith(WILDCARD_SUFFIX)) {
+                    String serviceAndType = resource.substring(0, resource.length() - WILDCARD_SUFFIX.length());
+                    int separator = serviceAndType.indexOf(SEPARATOR);
+                    if (separator > 0 && separator < serviceAndType.length() - 1
+                            && serviceAndType.indexOf(SEPARATOR, separator + 1) < 0) {
+                        wildcardResourceTypes.computeIfAbsent(serviceAndType.substring(0, separator),
+                                k -> new HashSet<>()).add(serviceAndType.substring(separator + 1));
+                    }
+                }
+                addMqttTopicFilter(resource, MQTT_TOPIC_RESOURCE_TYPE);
+                addMqttTopicFilter(resource, MQTT_TOPIC_FILTER_RESOURCE_TYPE);
+            }
+
+            private void addMqttTopicFilter(String resource, String resourceType) {
+                int nameStart = MQTT_SERVICE.length() + resourceType.length() + 2;
+                if (resource.length() < nameStart || !resource.startsWith(MQTT_SERVICE)
+                        || resource.charAt(MQTT_SERVICE.length()) != SEPARATOR
+                        || !resource.startsWith(resourceType, MQTT_SERVICE.length() + 1)
+                        || resource.charAt(nameStart - 1) != SEPARATOR) {
+                    return;
+                }
+                String filter = resource.substring(nameStart);
+                // Filters with misplaced wildcards are only ever matched exactly
+                if ((overlap || TopicFilterTrie.hasWildcards(filter)) && TopicFilterTrie.isValidFilter(filter)) {
+                    mqttTopicFilters.computeIfAbsent(resourceType, k -> new TopicFilterTrie()).add(filter);
+                }
+            }
+
+            ResourceIndex build() {
+                if (!anyResource && exactResources.isEmpty() && wildcardResourceTypes.isEmpty()
+                        && mqttTopicFilters.isEmpty() && templates.isEmpty()) {
+                    return EMPTY;
+                }
+                Map<String, Set<String>> resourceTypes = new HashMap<>();
+                for (Map.Entry<String, Set<String>> entry : wildcardResourceTypes.entrySet()) {
+                    resourceTypes.put(entry.getKey(), Collections.unmodifiableSet(entry.getValue()));
+                }
+                return new ResourceIndex(overlap, anyResource, Collections.unmodifiableSet(exactResources),
+                        Collections.unmodifiableMap(resourceTypes), Collections.unmodifiableMap(mqttTopicFilters),
+                        templates.toArray(new ResourceTemplate[0]));
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.function.IntConsumer;
+
+/**
+ * Character trie mapping string prefixes to integer identifiers, e.g. device group indices.
+ *
+ * <p>Finding every prefix of a value costs one step per character of the value, regardless of how
+ * many prefixes are stored. Tries are populated once through {@link #add(String, int)} and are safe
+ * for concurrent reads afterwards, as long as they are published safely.</p>
+ */
+public final class PrefixTrie {
+    private static final int[] NO_IDS = new int[0];
+
+    private final Node root = new Node();
+    private boolean empty = true;
+
+    /**
+     * Associate an identifier with a prefix.
+     *
+     * @param prefix prefix, may be empty to match every value
+     * @param id     identifier
+     */
+    public void add(String prefix, int id) {
+        Node node = root;
+        for (int i = 0; i < prefix.length(); i++) {
+            node = node.children.computeIfAbsent(prefix.charAt(i), k -> new Node());
+        }
+        node.addId(id);
+        empty = false;
+    }
+
+    public boolean isEmpty() {
+        return empty;
+    }
+
+    /**
+     * Visit the identifiers of every stored prefix of the given value.
+     *
+     * @param value    value to look up
+     * @param consumer identifier consumer, may be called more than once for the same identifier
+     */
+    public void forEachPrefixOf(String value, IntConsumer consumer) {
+        Node node = root;
+        for (int i = 0; ; i++) {
+            for (int id : node.ids) {
+                consumer.accept(id);
+            }
+            if (i == value.length()) {
+                return;
+            }
+            node = node.children.get(value.charAt(i));
+            if (node == null) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * Check whether any stored prefix is a prefix of the given value.
+     *
+     * @param value value to look up
+     * @return true if the value starts with a stored prefix
+     */
+    public boolean containsPrefixOf(String value) {
+        Node node = root;
+        for (int i = 0; ; i++) {
+            if (node.ids.length > 0) {
+                return true;
+            }
+            if (i == value.length()) {
+                return false;
+            }
+            node = node.children.get(value.charAt(i));
+            if (node == null) {
+                return false;
+            }
+        }
+    }
+
+    private static final class Node {
+        private final Map<Character, Node> children = new HashMap<>();
+        private int[] ids = NO_IDS;
+
+        void addId(int id) {
+            for (int existing : ids) {
+                if (existing == id) {
+                    return;
+                }
+            }
+            ids = Arrays.copyOf(ids, ids.length + 1);
+            ids[ids.length - 1] = id;
+        }
+    }
+}
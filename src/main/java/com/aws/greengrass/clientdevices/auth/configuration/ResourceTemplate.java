@@ -0,0 +1,417 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import com.aws.greengrass.clientdevices.auth.session.attribute.DeviceAttribute;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Policy resource containing policy variables, e.g. 'mqtt:topic:devices/${iot:Connection.Thing.ThingName}/data'.
+ *
+ * <p>Templates are compiled once into alternating literal and variable segments. Variables of the form
+ * '${iot:Connection.Namespace.Attribute}' refer to the session attribute 'Attribute' of namespace 'Namespace',
+ * e.g. '${iot:Connection.Thing.ThingName}'. A requested resource matches if it equals the template with every
+ * variable replaced by its session attribute value. MQTT topic and topic filter templates are also compiled into
+ * topic levels, so that templates containing '+' or '#' are matched with MQTT wildcard semantics. Either way
+ * segments are compared in place against the request, so no substituted string is built. Within topic levels,
+ * variable values containing '/', '+' or '#' never match.</p>
+ */
+public final class ResourceTemplate {
+    private static final String VARIABLE_START = "${";
+    private static final char VARIABLE_END = '}';
+    private static final String CONNECTION_VARIABLE_PREFIX = "iot:Connection.";
+    private static final String[] MQTT_TOPIC_PREFIXES = {"mqtt:topic:", "mqtt:topicfilter:"};
+    private static final char LEVEL_SEPARATOR = '/';
+    private static final char SINGLE_LEVEL_WILDCARD = '+';
+    private static final char MULTI_LEVEL_WILDCARD = '#';
+    private static final char SYSTEM_TOPIC_PREFIX = '$';
+
+    private final String template;
+    // literal text, or the attribute name for variable segments
+    private final String[] segments;
+    // attribute namespace for variable segments, null for literal segments
+    private final String[] namespaces;
+    // start of the topic name in MQTT topic and topic filter templates, or -1 for other resources
+    private final int mqttNameStart;
+    // topic levels of MQTT templates, or null for other resources and for misplaced wildcards
+    private final Level[] levels;
+    // true for MQTT templates with wildcard levels
+    private final boolean mqttWildcards;
+    // literal text which every matching resource starts with
+    private final String literalPrefix;
+
+    private ResourceTemplate(String template, String[] segments, String... namespaces) {
+        this.template = template;
+        this.segments = segments;
+        this.namespaces = namespaces;
+        int nameStart = -1;
+        if (namespaces[0] == null) {
+            for (String prefix : MQTT_TOPIC_PREFIXES) {
+                if (segments[0].startsWith(prefix)) {
+                    nameStart = prefix.length();
+                }
+            }
+        }
+        this.mqttNameStart = nameStart;
+        this.levels = nameStart < 0 ? null : compileLevels(segments, namespaces, nameStart);
+        boolean wildcards = false;
+        for (int i = 0; levels != null && i < levels.length; i++) {
+            wildcards |= levels[i].wildcard != 0;
+        }
+        this.mqttWildcards = wildcards;
+        String prefix = namespaces[0] == null ? segments[0] : "";
+        if (wildcards) {
+            int wildcard = firstWildcard(prefix, nameStart);
+            prefix = wildcard < 0 ? prefix : prefix.substring(0, wildcard);
+        }
+        this.literalPrefix = prefix;
+    }
+
+    /**
+     * Compile a policy resource into a template.
+     *
+     * @param resource policy resource
+     * @return resource template, or null if the resource does not contain any well-formed policy variable
+     */
+    public static ResourceTemplate compile(String resource) {
+        if (!resource.contains(VARIABLE_START)) {
+            return null;
+        }
+        List<String> segments = new ArrayList<>();
+        List<String> namespaces = new ArrayList<>();
+        int pos = 0;
+        while (pos < resource.length()) {
+            int variableStart = resource.indexOf(VARIABLE_START, pos);
+            int variableEnd = variableStart < 0 ? -1 : resource.indexOf(VARIABLE_END, variableStart);
+            if (variableEnd < 0) {
+                segments.add(resource.substring(pos));
+                namespaces.add(null);
+                break;
+            }
+            if (variableStart > pos) {
+                segments.add(resource.substring(pos, variableStart));
+                namespaces.add(null);
+            }
+            String variable = resource.substring(variableStart + VARIABLE_START.length(), variableEnd);
+            int separator = variable.indexOf('.', CONNECTION_VARIABLE_PREFIX.length());
+            if (!variable.startsWith(CONNECTION_VARIABLE_PREFIX) || separator < 0
+                    || separator == CONNECTION_VARIABLE_PREFIX.length() || separator == variable.length() - 1) {
+                return null;
+            }
+            segments.add(variable.substring(separator + 1));
+            namespaces.add(variable.substring(CONNECTION_VARIABLE_PREFIX.length(), separator));
+            pos = variableEnd + 1;
+        }
+        if (namespaces.stream().allMatch(namespace -> namespace == null)) {
+            return null;
+        }
+        return new ResourceTemplate(resource, segments.toArray(new String[0]), namespaces.toArray(new String[0]));
+    }
+
+    /**
+     * Split the topic name of an MQTT template into levels.
+     *
+     * @return levels, or null if a wildcard does not occupy a whole level or '#' is not the last level
+     */
+    private static Level[] compileLevels(String[] segments, String[] namespaces, int nameStart) {
+        List<Level> levels = new ArrayList<>();
+        List<String> parts = new ArrayList<>();
+        List<String> partNamespaces = new ArrayList<>();
+        for (int i = 0; i < segments.length; i++) {
+            if (namespaces[i] != null) {
+                parts.add(segments[i]);
+                partNamespaces.add(namespaces[i]);
+                continue;
+            }
+            String text = segments[i];
+            int start = i == 0 ? nameStart : 0;
+            while (true) {
+                int separator = text.indexOf(LEVEL_SEPARATOR, start);
+                int end = separator < 0 ? text.length() : separator;
+                if (end > start) {
+                    parts.add(text.substring(start, end));
+                    partNamespaces.add(null);
+                }
+                if (separator < 0) {
+                    break;
+                }
+                levels.add(new Level(parts, partNamespaces));
+                parts.clear();
+                partNamespaces.clear();
+                start = end + 1;
+            }
+        }
+        levels.add(new Level(parts, partNamespaces));
+        for (int i = 0; i < levels.size(); i++) {
+            Level level = levels.get(i);
+            if (level.wildcard == MULTI_LEVEL_WILDCARD && i != levels.size() - 1) {
+                return null;
+            }
+            for (int j = 0; level.wildcard == 0 && j < level.parts.length; j++) {
+                if (level.namespaces[j] == null && TopicFilterTrie.hasWildcards(level.parts[j])) {
+                    return null;
+                }
+            }
+        }
+        return levels.toArray(new Level[0]);
+    }
+
+    /**
+     * Get the literal text which every resource matched by this template starts with. Resources containing
+     * MQTT wildcards may overlap the template without starting with it.
+     *
+     * @return literal prefix, possibly empty
+     */
+    public String getLiteralPrefix() {
+        return literalPrefix;
+    }
+
+    /**
+     * Check whether a requested resource matches this template for the given session.
+     *
+     * @param resource requested resource
+     * @param session  session used to resolve policy variables, may be null
+     * @return true if the resource equals the template with all variables resolved, or for MQTT templates
+     *         with wildcards, if the resolved topic filter covers the resource. False if any variable
+     *         cannot be resolved
+     */
+    public boolean matches(String resource, Session session) {
+        if (session == null) {
+            return false;
+        }
+        if (!mqttWildcards) {
+            return equalsResolved(resource, session);
+        }
+        return sameResourceType(resource) && covers(resource, session);
+    }
+
+    /**
+     * Check whether a requested resource overlaps this template for the given session: for MQTT topic and
+     * topic filter templates, whether the resolved filter matches at least one topic of a requested filter.
+     * Other resources overlap only if they match.
+     *
+     * @param resource requested resource
+     * @param session  session used to resolve policy variables, may be null
+     * @return true if the resource overlaps the template with all variables resolved
+     */
+    public boolean overlaps(String resource, Session session) {
+        if (session == null) {
+            return false;
+        }
+        if (levels == null || !mqttWildcards && !TopicFilterTrie.hasWildcards(resource)) {
+            return equalsResolved(resource, session);
+        }
+        return sameResourceType(resource) && overlaps(resource, session);
+    }
+
+    private boolean sameResourceType(String resource) {
+        return resource.length() >= mqttNameStart && resource.regionMatches(0, template, 0, mqttNameStart);
+    }
+
+    /**
+     * Check whether the resolved topic filter covers the requested topic or topic filter, following
+     * {@link TopicFilterTrie#coversAny(String, int)}.
+     */
+    private boolean covers(String resource, Session session) {
+        int start = mqttNameStart;
+        for (int i = 0; i < levels.length; i++) {
+            Level level = levels[i];
+            boolean systemTopic = i == 0 && start < resource.length() && resource.charAt(start) == SYSTEM_TOPIC_PREFIX;
+            if (level.wildcard == MULTI_LEVEL_WILDCARD) {
+                return !systemTopic && isResolvable(session);
+            }
+            if (start > resource.length()) {
+                return false;
+            }
+            int end = levelEnd(resource, start);
+            if (isLevel(resource, start, end, MULTI_LEVEL_WILDCARD)) {
+                // Only a '#' covers a requested '#'
+                return false;
+            }
+            if (level.wildcard == SINGLE_LEVEL_WILDCARD) {
+                if (systemTopic) {
+                    return false;
+                }
+            } else if (isLevel(resource, start, end, SINGLE_LEVEL_WILDCARD)
+                    || !level.matches(resource, start, end, session)) {
+                return false;
+            }
+            start = end + 1;
+        }
+        return start > resource.length() && isResolvable(session);
+    }
+
+    /**
+     * Check whether the resolved topic filter and the requested topic or topic filter match some topic in common,
+     * following {@link TopicFilterTrie#overlapsAny(String, int)}.
+     */
+    private boolean overlaps(String resource, Session session) {
+        int start = mqttNameStart;
+        for (int i = 0; i < levels.length; i++) {
+            Level level = levels[i];
+            boolean systemTopic = i == 0 && start < resource.length() && resource.charAt(start) == SYSTEM_TOPIC_PREFIX;
+            if (level.wildcard == MULTI_LEVEL_WILDCARD) {
+                return !systemTopic && isResolvable(session);
+            }
+            if (start > resource.length()) {
+                return false;
+            }
+            int end = levelEnd(resource, start);
+            if (isLevel(resource, start, end, MULTI_LEVEL_WILDCARD)) {
+                // A requested '#' matches this level and every level below it
+                return (level.wildcard != 0 || i > 0 || !level.startsWithSystemPrefix(session))
+                        && isResolvable(session);
+            }
+            if (isLevel(resource, start, end, SINGLE_LEVEL_WILDCARD)) {
+                if (level.wildcard == 0 && (i == 0 && level.startsWithSystemPrefix(session)
+                        || !level.isResolvable(session))) {
+                    return false;
+                }
+            } else if (level.wildcard == SINGLE_LEVEL_WILDCARD) {
+                if (systemTopic) {
+                    return false;
+                }
+            } else if (!level.matches(resource, start, end, session)) {
+                return false;
+            }
+            start = end + 1;
+        }
+        // A requested '#' also matches the last level of the filter
+        return (start > resource.length() || isLevel(resource, start, levelEnd(resource, start),
+                MULTI_LEVEL_WILDCARD)) && isResolvable(session);
+    }
+
+    private boolean isResolvable(Session session) {
+        for (Level level : levels) {
+            if (!level.isResolvable(session)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    private boolean equalsResolved(String resource, Session session) {
+        int pos = 0;
+        for (int i = 0; i < segments.length; i++) {
+            String text = resolve(i, session);
+            if (text == null) {
+                return false;
+            }
+            if (!resource.startsWith(text, pos)) {
+                return false;
+            }
+            pos += text.length();
+        }
+        return pos == resource.length();
+    }
+
+    private String resolve(int segment, Session session) {
+        if (namespaces[segment] == null) {
+            return segments[segment];
+        }
+        DeviceAttribute attribute = session.getSessionAttribute(namespaces[segment], segments[segment]);
+        return attribute == null ? null : attribute.getValue();
+    }
+
+    private static int levelEnd(String topic, int start) {
+        int end = topic.indexOf(LEVEL_SEPARATOR, start);
+        return end < 0 ? topic.length() : end;
+    }
+
+    private static boolean isLevel(String topic, int start, int end, char wildcard) {
+        return end - start == 1 && topic.charAt(start) == wildcard;
+    }
+
+    private static int firstWildcard(String text, int fromIndex) {
+        for (int i = Math.max(fromIndex, 0); i < text.length(); i++) {
+            char c = text.charAt(i);
+            if (c == '+' || c == '#') {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    @Override
+    public String toString() {
+        return template;
+    }
+
+    /**
+     * Topic level of an MQTT template: a wildcard, or literal text and variables.
+     */
+    private static final class Level {
+        // '+' or '#' for wildcard levels, 0 otherwise
+        private final char wildcard;
+        // literal text, or the attribute name for variable parts
+        private final String[] parts;
+        // attribute namespace for variable parts, null for literal parts
+        private final String[] namespaces;
+
+        Level(List<String> parts, List<String> namespaces) {
+            this.parts = parts.toArray(new String[0]);
+            this.namespaces = namespaces.toArray(new String[0]);
+            char levelWildcard = 0;
+            if (this.parts.length == 1 && this.namespaces[0] == null && this.parts[0].length() == 1) {
+                char c = this.parts[0].charAt(0);
+                if (c == SINGLE_LEVEL_WILDCARD || c == MULTI_LEVEL_WILDCARD) {
+                    levelWildcard = c;
+                }
+            }
+            this.wildcard = levelWildcard;
+        }
+
+        boolean matches(String topic, int start, int end, Session session) {
+            int pos = start;
+            for (int i = 0; i < parts.length; i++) {
+                String text = resolve(i, session);
+                if (text == null || text.length() > end - pos || !topic.startsWith(text, pos)) {
+                    return false;
+                }
+                pos += text.length();
+            }
+            return pos == end;
+        }
+
+        boolean startsWithSystemPrefix(Session session) {
+            for (int i = 0; i < parts.length; i++) {
+                String text = resolve(i, session);
+                if (text != null && !text.isEmpty()) {
+                    return text.charAt(0) == SYSTEM_TOPIC_PREFIX;
+                }
+            }
+            return false;
+        }
+
+        boolean isResolvable(Session session) {
+            for (int i = 0; i < parts.length; i++) {
+                if (namespaces[i] != null && resolve(i, session) == null) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Resolve a part of the level. Variable values spanning several levels or containing wildcards are
+         * treated as unresolvable.
+         */
+        private String resolve(int part, Session session) {
+            if (namespaces[part] == null) {
+                return parts[part];
+            }
+            DeviceAttribute attribute = session.getSessionAttribute(namespaces[part], parts[part]);
+            String value = attribute == null ? null : attribute.getValue();
+            if (value == null || value.indexOf(LEVEL_SEPARATOR) >= 0 || TopicFilterTrie.hasWildcards(value)) {
+                return null;
+            }
+            return value;
+        }
+    }
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTAnd;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTOr;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTStart;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTThing;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.Node;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.RuleExpressionVisitor;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.SimpleNode;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import com.aws.greengrass.clientdevices.auth.session.attribute.DeviceAttribute;
+import com.aws.greengrass.clientdevices.auth.session.attribute.GlobPattern;
+import com.aws.greengrass.clientdevices.auth.session.attribute.WildcardSuffixAttribute;
+
+import java.util.ArrayList;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+import java.util.function.Predicate;
+
+/**
+ * Compiles selection rule expression trees into session predicates. The expression tree is walked once, when
+ * the group definition is built, and evaluating the resulting predicate neither allocates nor boxes.
+ *
+ * <p>OR and AND nodes may have any number of children, as produced by {@link RuleNormalizer}.</p>
+ */
+public final class RuleCompiler implements RuleExpressionVisitor {
+    private static final RuleCompiler INSTANCE = new RuleCompiler();
+
+    private RuleCompiler() {
+    }
+
+    /**
+     * Compile a selection rule expression tree.
+     *
+     * @param expressionTree parsed selection rule
+     * @return predicate returning true for sessions matching the selection rule
+     */
+    @SuppressWarnings("unchecked")
+    public static Predicate<Session> compile(ASTStart expressionTree) {
+        return (Predicate<Session>) expressionTree.jjtAccept(INSTANCE, null);
+    }
+
+    @SuppressWarnings("unchecked")
+    private static Predicate<Session>[] toArray(List<Predicate<Session>> predicates) {
+        return predicates.toArray(new Predicate[0]);
+    }
+
+    @SuppressWarnings("unchecked")
+    private Predicate<Session> compileChild(Node node, int index) {
+        return (Predicate<Session>) node.jjtGetChild(index).jjtAccept(this, null);
+    }
+
+    @Override
+    public Object visit(SimpleNode node, Object data) {
+        // Not used
+        return null;
+    }
+
+    @Override
+    public Object visit(ASTStart node, Object data) {
+        // Single child node
+        return compileChild(node, 0);
+    }
+
+    @Override
+    public Object visit(ASTOr node, Object data) {
+        List<String> thingNames = new ArrayList<>();
+        List<Predicate<Session>> expressions = new ArrayList<>();
+        for (int i = 0; i < node.jjtGetNumChildren(); i++) {
+            Node child = node.jjtGetChild(i);
+            if (child instanceof ASTThing) {
+                thingNames.add((String) ((ASTThing) child).jjtGetValue());
+            } else {
+                expressions.add(compileChild(node, i));
+            }
+        }
+        Predicate<Session>[] compiledExpressions = toArray(expressions);
+        if (thingNames.isEmpty()) {
+            return (Predicate<Session>) session -> {
+                for (Predicate<Session> expression : compiledExpressions) {
+                    if (expression.test(session)) {
+                        return true;
+                    }
+                }
+                return false;
+            };
+        }
+        return new AnyThingName(thingNames, compiledExpressions);
+    }
+
+    @Override
+    public Object visit(ASTAnd node, Object data) {
+        List<Predicate<Session>> expressions = new ArrayList<>(node.jjtGetNumChildren());
+        for (int i = 0; i < node.jjtGetNumChildren(); i++) {
+            expressions.add(compileChild(node, i));
+        }
+        Predicate<Session>[] compiledExpressions = toArray(expressions);
+        return (Predicate<Session>) session -> {
+            for (Predicate<Session> expression : compiledExpressions) {
+                if (!expression.test(session)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+    }
+
+    @Override
+    public Object visit(ASTThing node, Object data) {
+        GlobPattern thingName = GlobPattern.compile((String) node.jjtGetValue());
+        return (Predicate<Session>) session -> {
+            DeviceAttribute attribute = session.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE);
+            return attribute != null && attribute.matches(thingName);
+        };
+    }
+
+    /**
+     * Disjunction of thingName terms and nested expressions. Exact thing names are kept in a hash set and
+     * wildcard prefixes in a trie, so those terms cost a hash lookup and a trie walk however many there are.
+     * Terms with other wildcards are matched one by one against their compiled patterns.
+     */
+    private static final class AnyThingName implements Predicate<Session> {
+        private final GlobPattern[] thingNames;
+        private final Set<String> exactThingNames = new HashSet<>();
+        private final PrefixTrie thingNamePrefixes = new PrefixTrie();
+        private final GlobPattern[] thingNameGlobs;
+        private final Predicate<Session>[] expressions;
+
+        @SafeVarargs
+        AnyThingName(List<String> thingNames, Predicate<Session>... expressions) {
+            this.thingNames = new GlobPattern[thingNames.size()];
+            this.expressions = expressions;
+            List<GlobPattern> globs = new ArrayList<>();
+            for (int i = 0; i < thingNames.size(); i++) {
+                GlobPattern thingName = GlobPattern.compile(thingNames.get(i));
+                this.thingNames[i] = thingName;
+                if (thingName.isLiteral()) {
+                    exactThingNames.add(thingName.getPattern());
+                } else if (thingName.isPrefix()) {
+                    thingNamePrefixes.add(thingName.getPrefix(), 0);
+                } else {
+                    globs.add(thingName);
+                }
+            }
+            this.thingNameGlobs = globs.toArray(new GlobPattern[0]);
+        }
+
+        @Override
+        public boolean test(Session session) {
+            DeviceAttribute attribute = session.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE);
+            if (attribute != null && matchesThingName(attribute)) {
+                return true;
+            }
+            for (Predicate<Session> expression : expressions) {
+                if (expression.test(session)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        private boolean matchesThingName(DeviceAttribute attribute) {
+            if (attribute instanceof WildcardSuffixAttribute) {
+                String value = attribute.getValue();
+                if (exactThingNames.contains(value) || thingNamePrefixes.containsPrefixOf(value)) {
+                    return true;
+                }
+                for (GlobPattern thingName : thingNameGlobs) {
+                    if (attribute.matches(thingName)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            // Indexed terms assume wildcard suffix semantics, so match term by term for anything else
+            for (GlobPattern thingName : thingNames) {
+                if (attribute.matches(thingName)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+}
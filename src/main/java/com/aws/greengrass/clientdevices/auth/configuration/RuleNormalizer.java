@@ -0,0 +1,100 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTAnd;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTOr;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTStart;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTThing;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.Node;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.RuleExpressionTreeConstants;
+
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Deque;
+import java.util.List;
+import java.util.TreeSet;
+
+/**
+ * Normalizes selection rule expression trees.
+ *
+ * <p>The grammar builds OR and AND chains as right-recursive binary trees, so a rule with N alternatives is N
+ * levels deep. Normalization collapses chains of the same operator into a single n-ary node, removes duplicate
+ * thingName terms, and orders thingName terms by name ahead of any nested expression. Operators are free of
+ * side effects, so reordering operands does not change the result of a rule.</p>
+ */
+public final class RuleNormalizer {
+    private RuleNormalizer() {
+    }
+
+    /**
+     * Normalize an expression tree. The given tree is left unchanged.
+     *
+     * @param expressionTree parsed selection rule
+     * @return equivalent, normalized expression tree
+     */
+    public static ASTStart normalize(ASTStart expressionTree) {
+        ASTStart start = new ASTStart(RuleExpressionTreeConstants.JJTSTART);
+        setChildren(start, normalizeNode(expressionTree.jjtGetChild(0)));
+        return start;
+    }
+
+    private static Node normalizeNode(Node node) {
+        if (!(node instanceof ASTOr) && !(node instanceof ASTAnd)) {
+            return copyThing(node);
+        }
+
+        // Collect operands of the whole chain without recursing into it
+        Class<? extends Node> operator = node.getClass();
+        TreeSet<String> thingNames = new TreeSet<>();
+        List<Node> expressions = new ArrayList<>();
+        Deque<Node> pending = new ArrayDeque<>();
+        pending.push(node);
+        while (!pending.isEmpty()) {
+            Node current = pending.pop();
+            if (current.getClass() == operator) {
+                for (int i = current.jjtGetNumChildren() - 1; i >= 0; i--) {
+                    pending.push(current.jjtGetChild(i));
+                }
+            } else if (current instanceof ASTThing) {
+                thingNames.add((String) ((ASTThing) current).jjtGetValue());
+            } else {
+                expressions.add(normalizeNode(current));
+            }
+        }
+
+        List<Node> operands = new ArrayList<>(thingNames.size() + expressions.size());
+        for (String thingName : thingNames) {
+            operands.add(newThing(thingName));
+        }
+        operands.addAll(expressions);
+        if (operands.size() == 1) {
+            return operands.get(0);
+        }
+        Node normalized = node instanceof ASTOr ? new ASTOr(RuleExpressionTreeConstants.JJTOR)
+                : new ASTAnd(RuleExpressionTreeConstants.JJTAND);
+        setChildren(normalized, operands.toArray(new Node[0]));
+        return normalized;
+    }
+
+    private static Node copyThing(Node node) {
+        return newThing((String) ((ASTThing) node).jjtGetValue());
+    }
+
+    private static Node newThing(String thingName) {
+        ASTThing thing = new ASTThing(RuleExpressionTreeConstants.JJTTHING);
+        thing.jjtSetValue(thingName);
+        return thing;
+    }
+
+    private static void setChildren(Node parent, Node... children) {
+        // Add the last child first, so the child array is allocated once
+        for (int i = children.length - 1; i >= 0; i--) {
+            children[i].jjtSetParent(parent);
+            parent.jjtAddChild(children[i], i);
+        }
+    }
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * Trie of MQTT topic filters, with one level per topic level.
+ *
+ * <p>A lookup checks whether any stored filter covers a topic, or for subscriptions, whether any stored
+ * filter covers every topic of a requested filter. Either way it costs time proportional to the depth of the
+ * requested topic, not the number of stored filters. An overlap lookup instead checks whether any stored
+ * filter matches at least one topic of a requested filter, which is what deny statements need: a subscription
+ * to '#' must be refused if any topic below it is denied. Wildcards follow MQTT semantics: '+' matches exactly one
+ * level, a trailing '#' matches any number of levels including none, and neither matches a first level that
+ * starts with '$'. Tries are populated once through {@link #add(String)} and are safe for concurrent reads
+ * afterwards, as long as they are published safely.</p>
+ */
+public final class TopicFilterTrie {
+    private static final char LEVEL_SEPARATOR = '/';
+    private static final char SINGLE_LEVEL_WILDCARD = '+';
+    private static final char MULTI_LEVEL_WILDCARD = '#';
+    private static final char SYSTEM_TOPIC_PREFIX = '$';
+
+    private final Node root = new Node();
+
+    /**
+     * Check whether a topic filter contains MQTT wildcards.
+     *
+     * @param filter topic filter
+     * @return true if the filter contains '+' or '#'
+     */
+    public static boolean hasWildcards(String filter) {
+        return filter.indexOf(SINGLE_LEVEL_WILDCARD) >= 0 || filter.indexOf(MULTI_LEVEL_WILDCARD) >= 0;
+    }
+
+    /**
+     * Check whether a topic filter is valid: wildcards must occupy a whole level, and '#' must be the last level.
+     *
+     * @param filter topic filter
+     * @return true if the filter is valid
+     */
+    public static boolean isValidFilter(String filter) {
+        if (filter.isEmpty()) {
+            return false;
+        }
+        int start = 0;
+        while (true) {
+            int end = levelEnd(filter, start);
+            for (int i = start; i < end; i++) {
+                char c = filter.charAt(i);
+                if ((c == SINGLE_LEVEL_WILDCARD || c == MULTI_LEVEL_WILDCARD) && end - start != 1) {
+                    return false;
+                }
+            }
+            if (end == filter.length()) {
+                return true;
+            }
+            if (filter.charAt(start) == MULTI_LEVEL_WILDCARD && end - start == 1) {
+                return false;
+            }
+            start = end + 1;
+        }
+    }
+
+    /**
+     * Check whether a single topic filter covers a topic or topic filter.
+     *
+     * @param filter valid topic filter
+     * @param topic  topic or topic filter
+     * @return true if every topic matched by the given topic is matched by the filter
+     */
+    public static boolean covers(String filter, String topic) {
+        TopicFilterTrie trie = new TopicFilterTrie();
+        trie.add(filter);
+        return trie.coversAny(topic, 0);
+    }
+
+    /**
+     * Check whether a single topic filter matches at least one topic matched by a topic or topic filter.
+     *
+     * @param filter valid topic filter
+     * @param topic  topic or topic filter
+     * @return true if some topic is matched by both
+     */
+    public static boolean overlaps(String filter, String topic) {
+        TopicFilterTrie trie = new TopicFilterTrie();
+        trie.add(filter);
+        return trie.overlapsAny(topic, 0);
+    }
+
+    /**
+     * Add a topic filter.
+     *
+     * @param filter topic filter, which must be valid
+     */
+    public void add(String filter) {
+        Node node = root;
+        int start = 0;
+        while (true) {
+            int end = levelEnd(filter, start);
+            if (isLevel(filter, start, end, MULTI_LEVEL_WILDCARD)) {
+                node.multiLevel = true;
+                return;
+            }
+            if (isLevel(filter, start, end, SINGLE_LEVEL_WILDCARD)) {
+                if (node.singleLevel == null) {
+                    node.singleLevel = new Node();
+                }
+                node = node.singleLevel;
+            } else {
+                node = node.children.computeIfAbsent(filter.substring(start, end), k -> new Node());
+            }
+            if (end == filter.length()) {
+                node.terminal = true;
+                return;
+            }
+            start = end + 1;
+        }
+    }
+
+    /**
+     * Check whether any stored filter covers a topic or topic filter.
+     *
+     * @param topic     string containing the topic or topic filter
+     * @param fromIndex index at which the topic starts within the string
+     * @return true if a stored filter matches every topic matched by the given topic
+     */
+    public boolean coversAny(String topic, int fromIndex) {
+        return covers(root, topic, fromIndex, fromIndex);
+    }
+
+    /**
+     * Check whether any stored filter matches at least one topic matched by a topic or topic filter.
+     * For a topic without wildcards this is the same as {@link #coversAny(String, int)}.
+     *
+     * @param topic     string containing the topic or topic filter
+     * @param fromIndex index at which the topic starts within the string
+     * @return true if a stored filter and the given topic match some topic in common
+     */
+    public boolean overlapsAny(String topic, int fromIndex) {
+        return overlaps(root, topic, fromIndex, fromIndex);
+    }
+
+    private static boolean covers(Node node, String topic, int start, int topicStart) {
+        boolean systemTopic = start == topicStart && start < topic.length()
+                && topic.charAt(start) == SYSTEM_TOPIC_PREFIX;
+        if (node.multiLevel && !systemTopic) {
+            return true;
+        }
+        if (start > topic.length()) {
+            return node.terminal;
+        }
+        int end = levelEnd(topic, start);
+        if (isLevel(topic, start, end, MULTI_LEVEL_WILDCARD)) {
+            // Only a stored '#' covers a requested '#'
+            return false;
+        }
+        if (!isLevel(topic, start, end, SINGLE_LEVEL_WILDCARD)) {
+            Node child = node.children.get(topic.substring(start, end));
+            if (child != null && covers(child, topic, end + 1, topicStart)) {
+                return true;
+            }
+        }
+        return node.singleLevel != null && !systemTopic && covers(node.singleLevel, topic, end + 1, topicStart);
+    }
+
+    private static boolean overlaps(Node node, String topic, int start, int topicStart) {
+        boolean firstLevel = start == topicStart;
+        boolean systemTopic = firstLevel && start < topic.length() && topic.charAt(start) == SYSTEM_TOPIC_PREFIX;
+        if (node.multiLevel && !systemTopic) {
+            return true;
+        }
+        if (start > topic.length()) {
+            return node.terminal;
+        }
+        int end = levelEnd(topic, start);
+        if (isLevel(topic, start, end, MULTI_LEVEL_WILDCARD)) {
+            // A requested '#' also matches the parent level, and every stored filter below it
+            if (node.terminal || node.singleLevel != null) {
+                return true;
+            }
+            for (String level : node.children.keySet()) {
+                if (!firstLevel || !isSystemLevel(level)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (isLevel(topic, start, end, SINGLE_LEVEL_WILDCARD)) {
+            for (Map.Entry<String, Node> child : node.children.entrySet()) {
+                if ((!firstLevel || !isSystemLevel(child.getKey()))
+                        && overlaps(child.getValue(), topic, end + 1, topicStart)) {
+                    return true;
+                }
+            }
+        } else {
+            Node child = node.children.get(topic.substring(start, end));
+            if (child != null && overlaps(child, topic, end + 1, topicStart)) {
+                return true;
+            }
+        }
+        return node.singleLevel != null && !systemTopic && overlaps(node.singleLevel, topic, end + 1, topicStart);
+    }
+
+    private static boolean isSystemLevel(String level) {
+        return !level.isEmpty() && level.charAt(0) == SYSTEM_TOPIC_PREFIX;
+    }
+
+    private static int levelEnd(String topic, int start) {
+        int end = topic.indexOf(LEVEL_SEPARATOR, start);
+        return end < 0 ? topic.length() : end;
+    }
+
+    private static boolean isLevel(String topic, int start, int end, char wildcard) {
+        return end - start == 1 && topic.charAt(start) == wildcard;
+    }
+
+    private static final class Node {
+        private final Map<String, Node> children = new HashMap<>();
+        private Node singleLevel;
+        private boolean multiLevel;
+        private boolean terminal;
+    }
+}
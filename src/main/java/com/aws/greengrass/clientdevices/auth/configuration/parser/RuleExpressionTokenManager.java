@@ -308,16 +308,11 @@ private int jjMoveNfa_0(int startState, int curPos)
             switch(jjstateSet[--i])
             {
                case 4:
-                  if ((0x3ff200000000000L & l) != 0L)
-                  {
-                     if (kind > 6)
-                        kind = 6;
-                     { jjCheckNAddStates(0, 2); }
-                  }
-                  else if (curChar == 42)
+                  if ((0x3ff240000000000L & l) != 0L)
                   {
                      if (kind > 6)
                         kind = 6;
+                     { jjCheckNAddStates(0, 1); }
                   }
                   if ((0x3ff000000000000L & l) != 0L)
                   {
@@ -326,34 +321,25 @@ private int jjMoveNfa_0(int startState, int curPos)
                   }
                   break;
                case 5:
-                  if ((0x3ff200000000000L & l) != 0L)
-                  {
-                     if (kind > 6)
-                        kind = 6;
-                     { jjCheckNAddStates(0, 2); }
-                  }
-                  else if (curChar == 42)
+                  if ((0x3ff240000000000L & l) != 0L)
                   {
                      if (kind > 6)
                         kind = 6;
+                     { jjCheckNAddStates(0, 1); }
                   }
                   break;
                case 0:
-                  if ((0x3ff200000000000L & l) == 0L)
+                  if ((0x3ff240000000000L & l) == 0L)
                      break;
                   if (kind > 6)
                      kind = 6;
-                  { jjCheckNAddStates(0, 2); }
+                  { jjCheckNAddStates(0, 1); }
                   break;
                case 1:
                   if (curChar != 58)
                      break;
                   kind = 6;
-                  { jjCheckNAddStates(0, 2); }
-                  break;
-               case 3:
-                  if (curChar == 42)
-                     kind = 6;
+                  { jjCheckNAddStates(0, 1); }
                   break;
                default : break;
             }
@@ -371,7 +357,7 @@ private int jjMoveNfa_0(int startState, int curPos)
                   {
                      if (kind > 6)
                         kind = 6;
-                     { jjCheckNAddStates(0, 2); }
+                     { jjCheckNAddStates(0, 1); }
                   }
                   else if (curChar == 92)
                      jjstateSet[jjnewStateCnt++] = 1;
@@ -386,7 +372,7 @@ private int jjMoveNfa_0(int startState, int curPos)
                   {
                      if (kind > 6)
                         kind = 6;
-                     { jjCheckNAddStates(0, 2); }
+                     { jjCheckNAddStates(0, 1); }
                   }
                   else if (curChar == 92)
                      jjstateSet[jjnewStateCnt++] = 1;
@@ -396,7 +382,7 @@ private int jjMoveNfa_0(int startState, int curPos)
                      break;
                   if (kind > 6)
                      kind = 6;
-                  { jjCheckNAddStates(0, 2); }
+                  { jjCheckNAddStates(0, 1); }
                   break;
                case 2:
                   if (curChar == 92)
@@ -460,7 +446,7 @@ protected Token jjFillToken()
    return t;
 }
 static final int[] jjnextStates = {
-   0, 2, 3, 
+   0, 2, 
 };
 
 int curLexState = 0;
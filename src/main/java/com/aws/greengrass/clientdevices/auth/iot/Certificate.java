@@ -8,7 +8,9 @@ package com.aws.greengrass.clientdevices.auth.iot;
 import com.aws.greengrass.clientdevices.auth.session.attribute.AttributeProvider;
 import com.aws.greengrass.clientdevices.auth.session.attribute.DeviceAttribute;
 import com.aws.greengrass.clientdevices.auth.session.attribute.StringLiteralAttribute;
+import lombok.EqualsAndHashCode;
 import lombok.NonNull;
+import lombok.ToString;
 import lombok.Value;
 
 import java.util.Collections;
@@ -17,10 +19,20 @@ import java.util.Map;
 @Value
 public class Certificate implements AttributeProvider {
     public static final String NAMESPACE = "Certificate";
+    public static final String CERTIFICATE_ID_ATTRIBUTE = "CertificateId";
 
-    @NonNull
     String iotCertificateId; // Needed for certificate revocation
 
+    @EqualsAndHashCode.Exclude
+    @ToString.Exclude
+    Map<String, DeviceAttribute> deviceAttributes;
+
+    public Certificate(@NonNull String iotCertificateId) {
+        this.iotCertificateId = iotCertificateId;
+        this.deviceAttributes =
+                Collections.singletonMap(CERTIFICATE_ID_ATTRIBUTE, new StringLiteralAttribute(iotCertificateId));
+    }
+
     @Override
     public String getNamespace() {
         return NAMESPACE;
@@ -28,6 +40,6 @@ public class Certificate implements AttributeProvider {
 
     @Override
     public Map<String, DeviceAttribute> getDeviceAttributes() {
-        return Collections.singletonMap("CertificateId", new StringLiteralAttribute(getIotCertificateId()));
+        return deviceAttributes;
     }
 }
@@ -9,29 +9,34 @@ import com.aws.greengrass.logging.api.Logger;
 import com.aws.greengrass.logging.impl.LogManager;
 import com.aws.greengrass.util.Digest;
 import com.aws.greengrass.util.Utils;
+import lombok.AccessLevel;
+import lombok.Setter;
 
 import java.security.NoSuchAlgorithmException;
-import java.util.Collections;
+import java.time.Clock;
+import java.util.Iterator;
 import java.util.LinkedHashMap;
 import java.util.Map;
 import java.util.Optional;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.LongAdder;
 import javax.inject.Inject;
 
 
 public class CertificateRegistry {
     private static final Logger logger = LogManager.getLogger(CertificateRegistry.class);
-    public static final int REGISTRY_CACHE_SIZE = 50;
-    // holds mapping of certificateHash (SHA-256 hash of certificatePem) to IoT Certificate Id;
-    // size-bound by default cache size, evicts oldest written entry if the max size is reached
-    private static final Map<String, String> certificateHashToIdMap = Collections.synchronizedMap(
-            new LinkedHashMap<String, String>(REGISTRY_CACHE_SIZE, 0.75f, false) {
-                @Override
-                protected boolean removeEldestEntry(Map.Entry eldest) {
-                    return size() > REGISTRY_CACHE_SIZE;
-                }
-            });
+    // holds mapping of certificateHash (SHA-256 hash of certificatePem) to active IoT Certificate Id;
+    // access-ordered and size-bound by the configured cache size, so the least recently used entry is
+    // evicted first. Entries expire after the configured TTL so that deactivated certificates are rejected
+    private final Map<String, CachedCertificateId> certificateHashToIdMap = new LinkedHashMap<>(16, 0.75f, true);
+    private final LongAdder cacheHits = new LongAdder();
+    private final LongAdder cacheMisses = new LongAdder();
 
     private final IotAuthClient iotAuthClient;
+    @Setter
+    private volatile IotAuthCacheConfig cacheConfig;
+    @Setter(AccessLevel.PACKAGE)
+    private Clock clock = Clock.systemUTC();
 
     /**
      * Constructor.
@@ -45,14 +50,14 @@ public class CertificateRegistry {
 
     /**
      * Returns whether the provided certificate is valid and active.
+     * Active certificates are served from the local cache until their entry expires.
+     *
      * @param certificatePem Certificate PEM
      * @return true if the certificate is valid and active.
+     * @throws IllegalArgumentException for empty certificate PEM
      */
     public boolean isCertificateValid(String certificatePem) {
-        // TODO: Check cache instead of calling the cloud once we have certificate revocation
-        Optional<String> certId = fetchActiveCertificateId(certificatePem);
-        certId.ifPresent(id -> registerCertificateIdForPem(id, certificatePem));
-        return certId.isPresent();
+        return getIotCertificateIdForPem(certificatePem).isPresent();
     }
 
     /**
@@ -67,10 +72,16 @@ public class CertificateRegistry {
         if (Utils.isEmpty(certificatePem)) {
             throw new IllegalArgumentException("Certificate PEM is empty");
         }
-        Optional<String> certId = getAssociatedCertificateId(certificatePem).map(Optional::of)
-                .orElseGet(() -> fetchActiveCertificateId(certificatePem));
+        String certHash = getCertificateHash(certificatePem);
+        Optional<String> certId = getAssociatedCertificateId(certHash);
+        if (certId.isPresent()) {
+            cacheHits.increment();
+            return certId;
+        }
+        cacheMisses.increment();
 
-        certId.ifPresent(id -> registerCertificateIdForPem(id, certificatePem));
+        certId = fetchActiveCertificateId(certificatePem);
+        certId.ifPresent(id -> registerCertificateId(certHash, id));
         return certId;
     }
 
@@ -78,7 +89,39 @@ public class CertificateRegistry {
      * Clears registry cache.
      */
     public void clear() {
-        certificateHashToIdMap.clear();
+        synchronized (certificateHashToIdMap) {
+            certificateHashToIdMap.clear();
+        }
+    }
+
+    /**
+     * Evicts the cached mappings to an IoT certificate ID, so that the certificate is verified with IoT Core
+     * again on its next use, e.g. once it has been deactivated.
+     *
+     * @param certificateId IoT certificate ID
+     */
+    public void invalidateCertificate(String certificateId) {
+        synchronized (certificateHashToIdMap) {
+            certificateHashToIdMap.values().removeIf(cached -> cached.certificateId.equals(certificateId));
+        }
+    }
+
+    /**
+     * Get the number of certificate lookups served from the local cache.
+     *
+     * @return cache hit count
+     */
+    public long getCacheHitCount() {
+        return cacheHits.sum();
+    }
+
+    /**
+     * Get the number of certificate lookups which had to call IoT Core.
+     *
+     * @return cache miss count
+     */
+    public long getCacheMissCount() {
+        return cacheMisses.sum();
     }
 
     /**
@@ -92,25 +135,63 @@ public class CertificateRegistry {
     }
 
     /**
-     * Returns IoT Certificate ID associated locally for given certificate PEM.
+     * Returns unexpired IoT Certificate ID associated locally for given certificate hash.
      *
-     * @param certificatePem Certificate PEM
+     * @param certHash Certificate hash, or null if it could not be calculated
      * @return Certificate ID or empty optional
      */
-    private Optional<String> getAssociatedCertificateId(String certificatePem) {
-        return Optional.ofNullable(getCertificateHash(certificatePem))
-                .map(certificateHashToIdMap::get);
+    private Optional<String> getAssociatedCertificateId(String certHash) {
+        if (certHash == null) {
+            return Optional.empty();
+        }
+        synchronized (certificateHashToIdMap) {
+            CachedCertificateId cached = certificateHashToIdMap.get(certHash);
+            if (cached == null) {
+                return Optional.empty();
+            }
+            if (cached.expiresAtMillis <= clock.millis()) {
+                certificateHashToIdMap.remove(certHash);
+                return Optional.empty();
+            }
+            return Optional.of(cached.certificateId);
+        }
     }
 
     /**
-     * Locally caches IoT Certificate ID mapping for Certificate PEM.
+     * Locally caches IoT Certificate ID mapping for certificate hash, evicting least recently used
+     * entries beyond the cache size.
      *
+     * @param certHash      Certificate hash, or null if it could not be calculated
      * @param certificateId IoT Certificate ID
-     * @param certificatePem Certificate PEM
      */
-    private void registerCertificateIdForPem(String certificateId, String certificatePem) {
-        Optional.ofNullable(getCertificateHash(certificatePem))
-                .ifPresent(certHash -> certificateHashToIdMap.put(certHash, certificateId));
+    private void registerCertificateId(String certHash, String certificateId) {
+        long ttlSeconds = getCacheTtlSeconds();
+        if (certHash == null || ttlSeconds == 0) {
+            return;
+        }
+        long expiresAtMillis = clock.millis() + TimeUnit.SECONDS.toMillis(ttlSeconds);
+        int cacheSize = getCacheSize();
+        synchronized (certificateHashToIdMap) {
+            certificateHashToIdMap.put(certHash, new CachedCertificateId(certificateId, expiresAtMillis));
+            // Loop rather than removeEldestEntry, so that a reduced cache size takes effect at once
+            Iterator<CachedCertificateId> eldest = certificateHashToIdMap.values().iterator();
+            while (certificateHashToIdMap.size() > cacheSize && eldest.hasNext()) {
+                eldest.next();
+                eldest.remove();
+            }
+        }
+    }
+
+    private int getCacheSize() {
+        IotAuthCacheConfig config = cacheConfig;
+        return config == null ? IotAuthCacheConfig.DEFAULT_CERTIFICATE_CACHE_SIZE
+                : config.getCertificateCacheSize();
+    }
+
+    private long getCacheTtlSeconds() {
+        IotAuthCacheConfig config = cacheConfig;
+        return config == null ? IotAuthCacheConfig.DEFAULT_CERTIFICATE_CACHE_TTL_SECONDS
+                : config.getCertificateCacheTtlSeconds();
     }
 
     /**
@@ -126,4 +207,14 @@ public class CertificateRegistry {
         }
         return null;
     }
+
+    private static final class CachedCertificateId {
+        private final String certificateId;
+        private final long expiresAtMillis;
+
+        private CachedCertificateId(String certificateId, long expiresAtMillis) {
+            this.certificateId = certificateId;
+            this.expiresAtMillis = expiresAtMillis;
+        }
+    }
 }
@@ -0,0 +1,166 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.iot;
+
+import com.aws.greengrass.config.Topics;
+import com.aws.greengrass.logging.api.Logger;
+import com.aws.greengrass.logging.impl.LogManager;
+import com.aws.greengrass.util.Coerce;
+
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.ASSOCIATION_CACHE_SIZE_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.ASSOCIATION_CACHE_TTL_SECONDS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.ASSOCIATION_NEGATIVE_CACHE_TTL_SECONDS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.CERTIFICATE_CACHE_SIZE_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.CERTIFICATE_CACHE_TTL_SECONDS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.DEFAULT_MAX_ACTIVE_AUTH_TOKENS;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.PERFORMANCE_TOPIC;
+
+/**
+ * Configuration of the caches in front of IoT Core identity verification.
+ */
+@SuppressWarnings("PMD.DataClass")
+public class IotAuthCacheConfig {
+    private static final Logger LOGGER = LogManager.getLogger(IotAuthCacheConfig.class);
+    // one entry per client device which can hold a session
+    public static final int DEFAULT_CERTIFICATE_CACHE_SIZE = DEFAULT_MAX_ACTIVE_AUTH_TOKENS;
+    public static final int MIN_CERTIFICATE_CACHE_SIZE = 1;
+    public static final int MAX_CERTIFICATE_CACHE_SIZE = Integer.MAX_VALUE - 1;
+    // one entry per thing and certificate pair, which is one per client device in most deployments
+    public static final int DEFAULT_ASSOCIATION_CACHE_SIZE = DEFAULT_MAX_ACTIVE_AUTH_TOKENS;
+    // bounds how long a deactivated certificate is still accepted
+    public static final long DEFAULT_CERTIFICATE_CACHE_TTL_SECONDS = 300L;
+    // bounds how long a detached thing can still connect with the certificate
+    public static final long DEFAULT_ASSOCIATION_CACHE_TTL_SECONDS = 300L;
+    // kept short so that a thing attached after a failed connection can connect soon after
+    public static final long DEFAULT_ASSOCIATION_NEGATIVE_CACHE_TTL_SECONDS = 10L;
+
+    private final AtomicInteger certificateCacheSize = new AtomicInteger(DEFAULT_CERTIFICATE_CACHE_SIZE);
+    private final AtomicInteger associationCacheSize = new AtomicInteger(DEFAULT_ASSOCIATION_CACHE_SIZE);
+    private final AtomicLong certificateCacheTtlSeconds = new AtomicLong(DEFAULT_CERTIFICATE_CACHE_TTL_SECONDS);
+    private final AtomicLong associationCacheTtlSeconds = new AtomicLong(DEFAULT_ASSOCIATION_CACHE_TTL_SECONDS);
+    private final AtomicLong associationNegativeCacheTtlSeconds =
+            new AtomicLong(DEFAULT_ASSOCIATION_NEGATIVE_CACHE_TTL_SECONDS);
+
+    private final Topics configuration;
+
+    /**
+     * Constructor.
+     *
+     * @param configuration Configuration topic for this service
+     */
+    public IotAuthCacheConfig(Topics configuration) {
+        this.configuration = configuration;
+        updateConfiguredValues();
+
+        // update cache sizes and TTLs to the latest configured values
+        this.configuration.subscribe((whatHappened, node) -> updateConfiguredValues());
+    }
+
+    /**
+     * Get the maximum number of active certificates to cache.
+     *
+     * @return certificate cache size
+     */
+    public int getCertificateCacheSize() {
+        return certificateCacheSize.get();
+    }
+
+    /**
+     * Get the maximum number of thing and certificate associations to cache, positive and negative results alike.
+     *
+     * @return association cache size
+     */
+    public int getAssociationCacheSize() {
+        return associationCacheSize.get();
+    }
+
+    /**
+     * Get how long an active certificate is cached. Certificates are not cached if this is 0.
+     *
+     * @return certificate cache TTL in seconds
+     */
+    public long getCertificateCacheTtlSeconds() {
+        return certificateCacheTtlSeconds.get();
+    }
+
+    /**
+     * Get how long a thing is known to be attached to a certificate. Positive results are not cached if this is 0.
+     *
+     * @return association cache TTL in seconds
+     */
+    public long getAssociationCacheTtlSeconds() {
+        return associationCacheTtlSeconds.get();
+    }
+
+    /**
+     * Get how long a thing is known not to be attached to a certificate. Negative results are not cached if this
+     * is 0.
+     *
+     * @return negative association cache TTL in seconds
+     */
+    public long getAssociationNegativeCacheTtlSeconds() {
+        return associationNegativeCacheTtlSeconds.get();
+    }
+
+    private void updateConfiguredValues() {
+        certificateCacheSize.set(getConfiguredCacheSize(CERTIFICATE_CACHE_SIZE_TOPIC,
+                DEFAULT_CERTIFICATE_CACHE_SIZE));
+        associationCacheSize.set(getConfiguredCacheSize(ASSOCIATION_CACHE_SIZE_TOPIC,
+                DEFAULT_ASSOCIATION_CACHE_SIZE));
+        certificateCacheTtlSeconds.set(getConfiguredTtl(CERTIFICATE_CACHE_TTL_SECONDS_TOPIC,
+                DEFAULT_CERTIFICATE_CACHE_TTL_SECONDS));
+        associationCacheTtlSeconds.set(getConfiguredTtl(ASSOCIATION_CACHE_TTL_SECONDS_TOPIC,
+                DEFAULT_ASSOCIATION_CACHE_TTL_SECONDS));
+        associationNegativeCacheTtlSeconds.set(getConfiguredTtl(ASSOCIATION_NEGATIVE_CACHE_TTL_SECONDS_TOPIC,
+                DEFAULT_ASSOCIATION_NEGATIVE_CACHE_TTL_SECONDS));
+    }
+
+    /**
+     * Retrieves a configured cache size.
+     * Invalid values are clamped to the valid range, which is the same for every cache.
+     *
+     * @param topic        size configuration topic under performance
+     * @param defaultValue default size
+     * @return cache size
+     */
+    private int getConfiguredCacheSize(String topic, int defaultValue) {
+        if (configuration == null || configuration.isEmpty()) {
+            return defaultValue;
+        }
+        int configValue = Coerce.toInt(configuration.findOrDefault(defaultValue, PERFORMANCE_TOPIC, topic));
+
+        int clamped = Math.max(MIN_CERTIFICATE_CACHE_SIZE, Math.min(MAX_CERTIFICATE_CACHE_SIZE, configValue));
+        if (clamped != configValue) {
+            LOGGER.warn("Illegal value {} for configuration {}. Using clamped value {}",
+                    configValue, topic, clamped);
+        }
+        return clamped;
+    }
+
+    /**
+     * Retrieves a configured cache TTL.
+     * Negative values are replaced with the default.
+     *
+     * @param topic        TTL configuration topic under performance
+     * @param defaultValue default TTL in seconds
+     * @return TTL in seconds
+     */
+    private long getConfiguredTtl(String topic, long defaultValue) {
+        if (configuration == null || configuration.isEmpty()) {
+            return defaultValue;
+        }
+        long configValue = Coerce.toLong(configuration.findOrDefault(defaultValue, PERFORMANCE_TOPIC, topic));
+        if (configValue < 0) {
+            LOGGER.warn("Illegal value {} for configuration {}. Using default value {}",
+                    configValue, topic, defaultValue);
+            return defaultValue;
+        }
+        return configValue;
+    }
+}
@@ -11,6 +11,8 @@ import com.aws.greengrass.logging.impl.LogManager;
 import com.aws.greengrass.util.GreengrassServiceClientFactory;
 import com.aws.greengrass.util.RetryUtils;
 import com.aws.greengrass.util.Utils;
+import lombok.AccessLevel;
+import lombok.Setter;
 import software.amazon.awssdk.services.greengrassv2data.model.InternalServerException;
 import software.amazon.awssdk.services.greengrassv2data.model.ResourceNotFoundException;
 import software.amazon.awssdk.services.greengrassv2data.model.ThrottlingException;
@@ -19,9 +21,20 @@ import software.amazon.awssdk.services.greengrassv2data.model.VerifyClientDevice
 import software.amazon.awssdk.services.greengrassv2data.model.VerifyClientDeviceIdentityResponse;
 import software.amazon.awssdk.services.greengrassv2data.model.VerifyClientDeviceIoTCertificateAssociationRequest;
 
+import java.time.Clock;
 import java.time.Duration;
 import java.util.Arrays;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
 import java.util.Optional;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.FutureTask;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.function.Predicate;
 import javax.inject.Inject;
 
 public interface IotAuthClient {
@@ -29,6 +42,48 @@ public interface IotAuthClient {
 
     boolean isThingAttachedToCertificate(Thing thing, Certificate certificate);
 
+    /**
+     * Set the configuration of the caches in front of cloud calls. Clients without caches ignore it.
+     *
+     * @param cacheConfig cache configuration
+     */
+    default void setCacheConfig(IotAuthCacheConfig cacheConfig) {
+    }
+
+    /**
+     * Evict cached results about a thing, e.g. once it has been deleted or detached from its certificate.
+     *
+     * @param thingName IoT thing name
+     */
+    default void invalidateThing(String thingName) {
+    }
+
+    /**
+     * Evict cached results about a certificate, e.g. once it has been deactivated.
+     *
+     * @param certificateId IoT certificate ID
+     */
+    default void invalidateCertificate(String certificateId) {
+    }
+
+    /**
+     * Get the number of association checks served from the local cache. Clients without caches report 0.
+     *
+     * @return cache hit count
+     */
+    default long getAssociationCacheHitCount() {
+        return 0;
+    }
+
+    /**
+     * Get the number of association checks which were not served from the local cache.
+     *
+     * @return cache miss count
+     */
+    default long getAssociationCacheMissCount() {
+        return 0;
+    }
+
     class Default implements IotAuthClient {
         private static final Logger logger = LogManager.getLogger(Default.class);
         private static final RetryUtils.RetryConfig SERVICE_EXCEPTION_RETRY_CONFIG =
@@ -37,6 +92,21 @@ public interface IotAuthClient {
                         .build();
 
         private final GreengrassServiceClientFactory clientFactory;
+        // holds results of thing certificate association checks, keyed by thing name and certificate ID;
+        // access-ordered and size-bound by the configured association cache size. Entries expire after the
+        // positive or negative TTL
+        private final Map<String, CachedAssociation> associationCache = new LinkedHashMap<>(16, 0.75f, true);
+        // association checks being made with the cloud, so that concurrent connections of a device share one call
+        private final ConcurrentMap<String, FutureTask<Boolean>> inFlightAssociations = new ConcurrentHashMap<>();
+        // number of invalidations, guarded by associationCache. A check in flight during an invalidation
+        // does not cache its result, since it may have been read from the cloud before the change
+        private long associationInvalidations;
+        private final LongAdder associationCacheHits = new LongAdder();
+        private final LongAdder associationCacheMisses = new LongAdder();
+        @Setter
+        private volatile IotAuthCacheConfig cacheConfig;
+        @Setter(AccessLevel.PACKAGE)
+        private Clock clock = Clock.systemUTC();
 
         /**
          * Default IotAuthClient constructor.
@@ -80,8 +150,18 @@ public interface IotAuthClient {
             }
         }
 
+        /**
+         * Returns whether the thing is attached to the certificate. Results are cached for the configured
+         * positive or negative TTL, and concurrent checks of the same association share a single cloud call.
+         * Failed cloud calls are not cached.
+         *
+         * @param thing       IoT thing
+         * @param certificate client certificate
+         * @return true if the thing is attached to the certificate
+         * @throws IllegalArgumentException          if the thing name or certificate ID is missing
+         * @throws CloudServiceInteractionException if the association could not be verified
+         */
         @Override
-        @SuppressWarnings("PMD.AvoidCatchingGenericException")
         public boolean isThingAttachedToCertificate(Thing thing, Certificate certificate) {
             if (thing == null || Utils.isEmpty(thing.getThingName())) {
                 throw new IllegalArgumentException("No thing name available to validate");
@@ -91,6 +171,134 @@ public interface IotAuthClient {
                 throw new IllegalArgumentException("No IoT certificate ID available to validate");
             }
 
+            // Thing names can not contain '/', so the key is unambiguous
+            String key = thing.getThingName() + '/' + certificate.getIotCertificateId();
+            Boolean cached = getCachedAssociation(key);
+            if (cached != null) {
+                associationCacheHits.increment();
+                return cached;
+            }
+            associationCacheMisses.increment();
+
+            FutureTask<Boolean> task = new FutureTask<>(() -> {
+                long invalidations;
+                synchronized (associationCache) {
+                    invalidations = associationInvalidations;
+                }
+                // Another check may have completed since the cache was read
+                Boolean completed = getCachedAssociation(key);
+                if (completed != null) {
+                    return completed;
+                }
+                boolean attached = verifyThingAttachedToCertificate(thing, certificate);
+                cacheAssociation(key, attached, invalidations);
+                return attached;
+            });
+            FutureTask<Boolean> inFlight = inFlightAssociations.putIfAbsent(key, task);
+            if (inFlight == null) {
+                inFlight = task;
+                try {
+                    task.run();
+                } finally {
+                    inFlightAssociations.remove(key, task);
+                }
+            }
+            return getAssociationResult(inFlight);
+        }
+
+        @Override
+        public void invalidateThing(String thingName) {
+            String keyPrefix = thingName + '/';
+            invalidateAssociations(key -> key.startsWith(keyPrefix));
+        }
+
+        @Override
+        public void invalidateCertificate(String certificateId) {
+            String keySuffix = '/' + certificateId;
+            invalidateAssociations(key -> key.endsWith(keySuffix));
+        }
+
+        @Override
+        public long getAssociationCacheHitCount() {
+            return associationCacheHits.sum();
+        }
+
+        @Override
+        public long getAssociationCacheMissCount() {
+            return associationCacheMisses.sum();
+        }
+
+        private boolean getAssociationResult(FutureTask<Boolean> task) {
+            try {
+                return task.get();
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                throw new CloudServiceInteractionException(
+                        "Failed to verify certificate thing association, process got interrupted", e);
+            } catch (ExecutionException e) {
+                if (e.getCause() instanceof RuntimeException) {
+                    throw (RuntimeException) e.getCause();
+                }
+                throw new CloudServiceInteractionException("Failed to verify certificate thing association",
+                        e.getCause());
+            }
+        }
+
+        private Boolean getCachedAssociation(String key) {
+            synchronized (associationCache) {
+                CachedAssociation cached = associationCache.get(key);
+                if (cached == null) {
+                    return null;
+                }
+                if (cached.expiresAtMillis <= clock.millis()) {
+                    associationCache.remove(key);
+                    return null;
+                }
+                return cached.attached;
+            }
+        }
+
+        private void invalidateAssociations(Predicate<String> keyFilter) {
+            synchronized (associationCache) {
+                associationInvalidations++;
+                associationCache.keySet().removeIf(keyFilter);
+            }
+            // Later checks make a new cloud call rather than wait for one which started before the invalidation
+            inFlightAssociations.keySet().removeIf(keyFilter);
+        }
+
+        private void cacheAssociation(String key, boolean attached, long invalidations) {
+            IotAuthCacheConfig config = cacheConfig;
+            long ttlSeconds;
+            int cacheSize;
+            if (config == null) {
+                ttlSeconds = attached ? IotAuthCacheConfig.DEFAULT_ASSOCIATION_CACHE_TTL_SECONDS
+                        : IotAuthCacheConfig.DEFAULT_ASSOCIATION_NEGATIVE_CACHE_TTL_SECONDS;
+                cacheSize = IotAuthCacheConfig.DEFAULT_ASSOCIATION_CACHE_SIZE;
+            } else {
+                ttlSeconds = attached ? config.getAssociationCacheTtlSeconds()
+                        : config.getAssociationNegativeCacheTtlSeconds();
+                cacheSize = config.getAssociationCacheSize();
+            }
+            if (ttlSeconds == 0) {
+                return;
+            }
+            long expiresAtMillis = clock.millis() + TimeUnit.SECONDS.toMillis(ttlSeconds);
+            synchronized (associationCache) {
+                if (invalidations != associationInvalidations) {
+                    return;
+                }
+                associationCache.put(key, new CachedAssociation(attached, expiresAtMillis));
+                Iterator<CachedAssociation> eldest = associationCache.values().iterator();
+                while (associationCache.size() > cacheSize && eldest.hasNext()) {
+                    eldest.next();
+                    eldest.remove();
+                }
+            }
+        }
+
+        @SuppressWarnings("PMD.AvoidCatchingGenericException")
+        private boolean verifyThingAttachedToCertificate(Thing thing, Certificate certificate) {
             VerifyClientDeviceIoTCertificateAssociationRequest request =
                     VerifyClientDeviceIoTCertificateAssociationRequest.builder()
                             .clientDeviceThingName(thing.getThingName())
@@ -125,5 +333,15 @@ public interface IotAuthClient {
                                 certificate.getIotCertificateId(), thing.getThingName()), e);
             }
         }
+
+        private static final class CachedAssociation {
+            private final boolean attached;
+            private final long expiresAtMillis;
+
+            private CachedAssociation(boolean attached, long expiresAtMillis) {
+                this.attached = attached;
+                this.expiresAtMillis = expiresAtMillis;
+            }
+        }
     }
 }
@@ -7,7 +7,9 @@ package com.aws.greengrass.clientdevices.auth.iot;
 
 import com.aws.greengrass.clientdevices.auth.session.attribute.AttributeProvider;
 import com.aws.greengrass.clientdevices.auth.session.attribute.DeviceAttribute;
-import com.aws.greengrass.clientdevices.auth.session.attribute.WildcardSuffixAttribute;
+import com.aws.greengrass.clientdevices.auth.session.attribute.GlobAttribute;
+import lombok.EqualsAndHashCode;
+import lombok.ToString;
 import lombok.Value;
 
 import java.util.Collections;
@@ -17,10 +19,16 @@ import java.util.regex.Pattern;
 @Value
 public class Thing implements AttributeProvider {
     public static final String NAMESPACE = "Thing";
+    public static final String THING_NAME_ATTRIBUTE = "ThingName";
     private static final String thingNamePattern = "[a-zA-Z0-9\\-_:]+";
 
     String thingName;
 
+    // Built once, since attributes are looked up for every selection rule evaluation
+    @EqualsAndHashCode.Exclude
+    @ToString.Exclude
+    Map<String, DeviceAttribute> deviceAttributes;
+
     /**
      * Constructor.
      * @param thingName AWS IoT ThingName
@@ -31,6 +39,8 @@ public class Thing implements AttributeProvider {
             throw new IllegalArgumentException("Invalid thing name. The thing name must match \"[a-zA-Z0-9\\-_:]+\".");
         }
         this.thingName = thingName;
+        this.deviceAttributes =
+                Collections.singletonMap(THING_NAME_ATTRIBUTE, new GlobAttribute(thingName));
     }
 
     @Override
@@ -40,6 +50,6 @@ public class Thing implements AttributeProvider {
 
     @Override
     public Map<String, DeviceAttribute> getDeviceAttributes() {
-        return Collections.singletonMap("ThingName", new WildcardSuffixAttribute(thingName));
+        return deviceAttributes;
     }
 }
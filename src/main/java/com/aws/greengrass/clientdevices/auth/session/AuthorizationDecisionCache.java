@@ -0,0 +1,139 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * Bounded cache of authorization decisions made for a single session.
+ *
+ * <p>Decisions are keyed on operation and resource and tagged with the generation of the group
+ * configuration they were evaluated against. The cache is direct-mapped: a colliding entry simply
+ * replaces the previous one, so lookups never allocate and memory use is fixed per session.
+ * Entries from an older configuration generation are dropped the first time the cache is accessed
+ * with a newer generation.</p>
+ */
+public class AuthorizationDecisionCache {
+    public static final int DEFAULT_CAPACITY = 64;
+    private static final int MAX_CAPACITY = 1 << 16;
+
+    private final int mask;
+    private final LongAdder hits = new LongAdder();
+    private final LongAdder misses = new LongAdder();
+    private volatile Table table;
+
+    /**
+     * Constructor.
+     */
+    public AuthorizationDecisionCache() {
+        this(DEFAULT_CAPACITY);
+    }
+
+    /**
+     * Constructor.
+     *
+     * @param capacity maximum number of cached decisions, rounded up to a power of two
+     */
+    public AuthorizationDecisionCache(int capacity) {
+        if (capacity <= 0) {
+            throw new IllegalArgumentException("Capacity must be positive");
+        }
+        this.mask = tableSizeFor(capacity) - 1;
+    }
+
+    /**
+     * Look up a cached decision.
+     *
+     * @param generation group configuration generation the caller is evaluating against
+     * @param operation  requested operation
+     * @param resource   requested resource
+     * @return cached decision, or null if there is none for this generation
+     */
+    public Boolean get(long generation, String operation, String resource) {
+        Table current = table;
+        if (current == null || current.generation != generation) {
+            misses.increment();
+            return null;
+        }
+        Entry entry = current.entries[index(operation, resource)];
+        if (entry != null && entry.operation.equals(operation) && entry.resource.equals(resource)) {
+            hits.increment();
+            return entry.decision;
+        }
+        misses.increment();
+        return null;
+    }
+
+    /**
+     * Cache a decision.
+     *
+     * @param generation group configuration generation the decision was evaluated against
+     * @param operation  requested operation
+     * @param resource   requested resource
+     * @param decision   authorization decision
+     */
+    public void put(long generation, String operation, String resource, boolean decision) {
+        Table current = table;
+        if (current == null || current.generation < generation) {
+            current = new Table(generation, mask + 1);
+            table = current;
+        } else if (current.generation > generation) {
+            // Evaluated against a configuration that has already been replaced
+            return;
+        }
+        current.entries[index(operation, resource)] = new Entry(operation, resource, decision);
+    }
+
+    /**
+     * Drop all cached decisions.
+     */
+    public void clear() {
+        table = null;
+    }
+
+    public long getHitCount() {
+        return hits.sum();
+    }
+
+    public long getMissCount() {
+        return misses.sum();
+    }
+
+    private int index(String operation, String resource) {
+        int h = operation.hashCode() * 31 + resource.hashCode();
+        return (h ^ (h >>> 16)) & mask;
+    }
+
+    private static int tableSizeFor(int capacity) {
+        int size = 1;
+        while (size < capacity && size < MAX_CAPACITY) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    private static final class Table {
+        private final long generation;
+        private final Entry[] entries;
+
+        Table(long generation, int size) {
+            this.generation = generation;
+            this.entries = new Entry[size];
+        }
+    }
+
+    private static final class Entry {
+        private final String operation;
+        private final String resource;
+        private final boolean decision;
+
+        Entry(String operation, String resource, boolean decision) {
+            this.operation = operation;
+            this.resource = resource;
+            this.decision = decision;
+        }
+    }
+}
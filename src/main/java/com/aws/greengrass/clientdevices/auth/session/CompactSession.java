@@ -0,0 +1,139 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Component;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.attribute.AttributeProvider;
+import com.aws.greengrass.clientdevices.auth.session.attribute.DeviceAttribute;
+import lombok.NonNull;
+
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.function.Function;
+
+/**
+ * Immutable session with a compact memory layout, for gateways holding many sessions.
+ *
+ * <p>The certificate, thing and component providers are held in fixed fields rather than in a map, and
+ * any other provider in a small overflow map which is only allocated when needed. The authorization
+ * decision cache is allocated on first use. Attribute providers can not be added once the session is
+ * created.</p>
+ */
+public final class CompactSession implements Session {
+    private static final Component COMPONENT = new Component();
+
+    private final Certificate certificate;
+    private final Thing thing;
+    private final boolean component;
+    // Providers in other namespaces, or null if there are none
+    private final Map<String, AttributeProvider> otherProviders;
+
+    private volatile AuthorizationDecisionCache authorizationDecisionCache;
+    private volatile GroupMembership groupMembership;
+
+    /**
+     * Constructor.
+     *
+     * @param certificate client certificate
+     * @param thing       thing the client connects as, or null
+     * @param component   true if the client is a Greengrass component
+     */
+    public CompactSession(@NonNull Certificate certificate, Thing thing, boolean component) {
+        this(certificate, thing, component, Collections.emptyMap());
+    }
+
+    /**
+     * Constructor.
+     *
+     * @param certificate    client certificate
+     * @param thing          thing the client connects as, or null
+     * @param component      true if the client is a Greengrass component
+     * @param otherProviders attribute providers in other namespaces
+     */
+    public CompactSession(@NonNull Certificate certificate, Thing thing, boolean component,
+                          @NonNull Map<String, AttributeProvider> otherProviders) {
+        this.certificate = certificate;
+        this.thing = thing;
+        this.component = component;
+        this.otherProviders = otherProviders.isEmpty() ? null
+                : Collections.unmodifiableMap(new HashMap<>(otherProviders));
+    }
+
+    @Override
+    public AttributeProvider getAttributeProvider(String attributeProviderNameSpace) {
+        if (Certificate.NAMESPACE.equals(attributeProviderNameSpace)) {
+            return certificate;
+        }
+        if (Thing.NAMESPACE.equals(attributeProviderNameSpace)) {
+            return thing;
+        }
+        if (Component.NAMESPACE.equals(attributeProviderNameSpace)) {
+            return component ? COMPONENT : null;
+        }
+        return otherProviders == null ? null : otherProviders.get(attributeProviderNameSpace);
+    }
+
+    /**
+     * Not supported, since the session is immutable.
+     *
+     * @throws UnsupportedOperationException always
+     */
+    @Override
+    public AttributeProvider putAttributeProvider(String attributeProviderNameSpace,
+                                                  AttributeProvider attributeProvider) {
+        throw new UnsupportedOperationException("Compact sessions are immutable");
+    }
+
+    /**
+     * Get the attribute provider of a namespace. Providers can not be added to the session.
+     *
+     * @throws UnsupportedOperationException if the session has no provider for the namespace
+     */
+    @Override
+    public AttributeProvider computeAttributeProviderIfAbsent(String attributeProviderNameSpace,
+                                                              Function<? super String, ? extends AttributeProvider>
+                                                                      mappingFunction) {
+        AttributeProvider provider = getAttributeProvider(attributeProviderNameSpace);
+        if (provider == null) {
+            throw new UnsupportedOperationException("Compact sessions are immutable");
+        }
+        return provider;
+    }
+
+    @Override
+    public DeviceAttribute getSessionAttribute(String attributeNamespace, String attributeName) {
+        AttributeProvider provider = getAttributeProvider(attributeNamespace);
+        return provider == null ? null : provider.getDeviceAttributes().get(attributeName);
+    }
+
+    @Override
+    public AuthorizationDecisionCache getAuthorizationDecisionCache() {
+        AuthorizationDecisionCache cache = authorizationDecisionCache;
+        if (cache == null) {
+            synchronized (this) {
+                cache = authorizationDecisionCache;
+                if (cache == null) {
+                    cache = new AuthorizationDecisionCache();
+                    authorizationDecisionCache = cache;
+                }
+            }
+        }
+        return cache;
+    }
+
+    @Override
+    public GroupMembership getGroupMembership() {
+        return groupMembership;
+    }
+
+    @Override
+    public void setGroupMembership(GroupMembership groupMembership) {
+        this.groupMembership = groupMembership;
+    }
+}
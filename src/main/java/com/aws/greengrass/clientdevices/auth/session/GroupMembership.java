@@ -0,0 +1,46 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import java.util.Arrays;
+
+/**
+ * Immutable record of the device groups a session belongs to, as indices into the group list of the
+ * group configuration generation it was computed against.
+ */
+public final class GroupMembership {
+    private final long generation;
+    private final int[] groupIndices;
+
+    /**
+     * Constructor.
+     *
+     * @param generation   group configuration generation the membership was computed against
+     * @param groupIndices indices of the matching groups
+     */
+    public GroupMembership(long generation, int... groupIndices) {
+        this.generation = generation;
+        this.groupIndices = Arrays.copyOf(groupIndices, groupIndices.length);
+    }
+
+    public long getGeneration() {
+        return generation;
+    }
+
+    public int size() {
+        return groupIndices.length;
+    }
+
+    /**
+     * Get the group index at the given position.
+     *
+     * @param position position in [0, size())
+     * @return group index
+     */
+    public int getGroupIndex(int position) {
+        return groupIndices[position];
+    }
+}
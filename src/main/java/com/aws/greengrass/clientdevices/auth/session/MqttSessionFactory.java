@@ -10,15 +10,20 @@ import com.aws.greengrass.clientdevices.auth.exception.AuthenticationException;
 import com.aws.greengrass.clientdevices.auth.exception.CloudServiceInteractionException;
 import com.aws.greengrass.clientdevices.auth.iot.Certificate;
 import com.aws.greengrass.clientdevices.auth.iot.CertificateRegistry;
-import com.aws.greengrass.clientdevices.auth.iot.Component;
 import com.aws.greengrass.clientdevices.auth.iot.IotAuthClient;
 import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.logging.api.Logger;
+import com.aws.greengrass.logging.impl.LogManager;
+import com.aws.greengrass.util.Digest;
+import com.aws.greengrass.util.Utils;
 
+import java.security.NoSuchAlgorithmException;
 import java.util.Map;
 import java.util.Optional;
 import javax.inject.Inject;
 
 public class MqttSessionFactory implements SessionFactory {
+    private static final Logger logger = LogManager.getLogger(MqttSessionFactory.class);
     private final IotAuthClient iotAuthClient;
     private final DeviceAuthClient deviceAuthClient;
     private final CertificateRegistry certificateRegistry;
@@ -52,6 +57,24 @@ public class MqttSessionFactory implements SessionFactory {
         return createIotThingSession(mqttCredential);
     }
 
+    /**
+     * Sessions are reused for the same certificate and client ID, identified by the SHA-256 hash of the
+     * certificate PEM. Username and password are not used for authentication, so they are not part of the key.
+     */
+    @Override
+    public String getSessionKey(Map<String, String> credentialMap) {
+        MqttCredential mqttCredential = new MqttCredential(credentialMap);
+        if (Utils.isEmpty(mqttCredential.certificatePem) || mqttCredential.clientId == null) {
+            return null;
+        }
+        try {
+            return Digest.calculate(mqttCredential.certificatePem) + ':' + mqttCredential.clientId;
+        } catch (NoSuchAlgorithmException e) {
+            logger.atWarn().cause(e).log("Unable to hash certificate. Session will not be reused");
+            return null;
+        }
+    }
+
     private Session createIotThingSession(MqttCredential mqttCredential) throws AuthenticationException {
         Optional<String> certificateId;
         try {
@@ -64,9 +87,7 @@ public class MqttSessionFactory implements SessionFactory {
             if (!iotAuthClient.isThingAttachedToCertificate(thing, cert)) {
                 throw new AuthenticationException("unable to authenticate device");
             }
-            Session session = new SessionImpl(cert);
-            session.putAttributeProvider(Thing.NAMESPACE, thing);
-            return session;
+            return new CompactSession(cert, thing, false);
         } catch (CloudServiceInteractionException e) {
             throw new AuthenticationException("Failed to verify certificate with cloud", e);
         }
@@ -74,9 +95,7 @@ public class MqttSessionFactory implements SessionFactory {
 
     private Session createGreengrassComponentSession(MqttCredential mqttCredential) {
         Certificate cert = new Certificate(mqttCredential.clientId);
-        Session session = new SessionImpl(cert);
-        session.putAttributeProvider(Component.NAMESPACE, new Component());
-        return session;
+        return new CompactSession(cert, null, true);
     }
 
     private static class MqttCredential {
@@ -48,4 +48,25 @@ public interface Session {
      * @return Session attribute
      */
     DeviceAttribute getSessionAttribute(String attributeNamespace, String attributeName);
+
+    /**
+     * Get the cache of authorization decisions made for this session.
+     *
+     * @return Authorization decision cache
+     */
+    AuthorizationDecisionCache getAuthorizationDecisionCache();
+
+    /**
+     * Get the memoized device group membership of this session.
+     *
+     * @return Group membership, or null if it has not been computed yet
+     */
+    GroupMembership getGroupMembership();
+
+    /**
+     * Memoize the device group membership of this session.
+     *
+     * @param groupMembership Group membership
+     */
+    void setGroupMembership(GroupMembership groupMembership);
 }
@@ -0,0 +1,579 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.attribute.AttributeProvider;
+import com.aws.greengrass.logging.api.Logger;
+import com.aws.greengrass.logging.impl.LogManager;
+
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.HashSet;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.IntSupplier;
+import java.util.function.LongSupplier;
+
+/**
+ * Bounded, lock-striped session cache with approximate LRU eviction and time-based expiry.
+ *
+ * <p>Sessions are spread over a fixed number of segments by session ID. Each segment is an access-ordered
+ * {@link LinkedHashMap} guarded by its own lock, so concurrent lookups of different sessions rarely contend.
+ * The head of each segment is its least recently used and longest idle session. When the cache is over
+ * capacity, the segment heads are compared and the least recently used one is evicted, so eviction costs
+ * one lock acquisition per segment. Capacity and timeouts are read on every use, so they can change at
+ * runtime; a lower capacity is enforced on the next insertion.</p>
+ *
+ * <p>Idle sessions are expired from the segment heads and sessions past their maximum lifetime from a
+ * creation-ordered queue, so each session is expired at most once and the cache is never scanned.</p>
+ *
+ * <p>Live sessions are also indexed by thing name and certificate ID, so that every session of a thing or
+ * certificate can be invalidated at a cost proportional to the number of sessions invalidated.</p>
+ *
+ * <p>An optional {@link Listener} is told about every change while the segment lock is held, so the changes
+ * to each session are reported in the order they happened.</p>
+ *
+ * <p>Sessions restored from a previous run are keyed by their persisted ID, and can neither be looked up nor
+ * reused until {@link #claim(String, String, long)} moves them to their session ID.</p>
+ */
+final class SessionCache {
+    private static final Logger logger = LogManager.getLogger(SessionCache.class);
+    private static final String SESSION_ID = "SessionId";
+    static final int SEGMENT_COUNT = 16;
+
+    private final Segment[] segments = new Segment[SEGMENT_COUNT];
+    private final AtomicInteger size = new AtomicInteger();
+    // Restored sessions not claimed yet, so that lookup misses only try to claim while there are any
+    private final AtomicInteger unclaimedSessions = new AtomicInteger();
+    private final IntSupplier capacity;
+    private final LongSupplier idleTimeoutMillis;
+    private final LongSupplier maxLifetimeMillis;
+
+    // Sessions in creation order, for expiring sessions past their maximum lifetime. Guarded by itself.
+    private final Deque<Entry> creationOrder = new ArrayDeque<>();
+
+    // Live sessions by session key, so that clients authenticating again with identical credentials, e.g.
+    // flapping devices, reuse their session without another cloud call.
+    private final Map<String, Entry> sessionsByKey = new ConcurrentHashMap<>();
+
+    // Live sessions by thing name and by certificate ID. Each set is only accessed within a compute of its map.
+    private final Map<String, Set<Entry>> sessionsByThingName = new ConcurrentHashMap<>();
+    private final Map<String, Set<Entry>> sessionsByCertificateId = new ConcurrentHashMap<>();
+
+    private volatile Listener listener;
+
+    /**
+     * Constructor.
+     *
+     * @param capacity          maximum number of sessions
+     * @param idleTimeoutMillis idle timeout, or 0 if sessions do not expire when idle
+     * @param maxLifetimeMillis maximum session lifetime, or 0 if sessions have no maximum lifetime
+     */
+    SessionCache(IntSupplier capacity, LongSupplier idleTimeoutMillis, LongSupplier maxLifetimeMillis) {
+        this.capacity = capacity;
+        this.idleTimeoutMillis = idleTimeoutMillis;
+        this.maxLifetimeMillis = maxLifetimeMillis;
+        for (int i = 0; i < SEGMENT_COUNT; i++) {
+            segments[i] = new Segment();
+        }
+    }
+
+    /**
+     * Look up a live session and mark it as used.
+     *
+     * @param sessionId session ID
+     * @param now       current time in milliseconds
+     * @return session, or null if there is no live session with this ID
+     */
+    Session get(String sessionId, long now) {
+        Segment segment = segmentFor(sessionId);
+        synchronized (segment) {
+            expireIdle(segment, now);
+            Entry entry = segment.entries.get(sessionId);
+            if (entry == null || entry.restored) {
+                return null;
+            }
+            // Sessions created before a maximum lifetime was configured are not in creationOrder
+            if (isExpired(entry, now)) {
+                logger.atDebug().kv(SESSION_ID, sessionId).log("Session expired. Closing session.");
+                remove(segment, entry);
+                return null;
+            }
+            touch(entry, now);
+            return entry.session;
+        }
+    }
+
+    /**
+     * Look up a live session by session key, mark it as used and add a reference to it. Sessions created
+     * too long ago are not reused, so that the credentials are validated again; they stay valid for the
+     * clients already holding them.
+     *
+     * @param sessionKey    session key
+     * @param now           current time in milliseconds
+     * @param maxAgeMillis  maximum time since the session was created, in milliseconds
+     * @return session ID, or null if there is no live session with this key which can be reused
+     */
+    String reuse(String sessionKey, long now, long maxAgeMillis) {
+        Entry entry = sessionsByKey.get(sessionKey);
+        if (entry == null) {
+            return null;
+        }
+        Segment segment = segmentFor(entry.sessionId);
+        synchronized (segment) {
+            if (entry.removed) {
+                return null;
+            }
+            if (isExpired(entry, now)) {
+                remove(segment, entry);
+                return null;
+            }
+            if (now - entry.createdMillis >= maxAgeMillis) {
+                return null;
+            }
+            // Refresh the session's position in the access order
+            segment.entries.get(entry.sessionId);
+            touch(entry, now);
+            entry.references++;
+            Listener l = listener;
+            if (l != null) {
+                l.sessionReferencesChanged(entry.sessionId, entry.references);
+            }
+            return entry.sessionId;
+        }
+    }
+
+    boolean containsKey(String sessionId) {
+        Segment segment = segmentFor(sessionId);
+        synchronized (segment) {
+            return segment.entries.containsKey(sessionId);
+        }
+    }
+
+    /**
+     * Add a session, then expire and evict sessions as needed.
+     *
+     * @param sessionId  session ID
+     * @param session    session
+     * @param sessionKey session key, or null if the session must not be reused
+     * @param now        current time in milliseconds
+     */
+    void put(String sessionId, Session session, String sessionKey, long now) {
+        put(new Entry(sessionId, session, sessionKey, now, now, 1, false), now, true);
+    }
+
+    /**
+     * Add a session restored from a previous run, without reporting it to the listener. Sessions must be
+     * restored in creation order, and live sessions with the same ID are kept.
+     *
+     * @param restoredId    persisted ID of the session
+     * @param session       session
+     * @param sessionKey    session key, or null if the session must not be reused
+     * @param createdMillis time the session was created, in milliseconds
+     * @param references    number of references to the session
+     * @param now           current time in milliseconds
+     */
+    void restore(String restoredId, Session session, String sessionKey, long createdMillis, int references,
+                 long now) {
+        Entry entry = new Entry(restoredId, session, sessionKey, createdMillis, now, references, true);
+        if (isExpired(entry, now) || containsKey(restoredId)) {
+            return;
+        }
+        put(entry, now, false);
+    }
+
+    /**
+     * Move a restored session to the session ID presented by its client, without reporting it to the
+     * listener, which persists the session under the same ID either way.
+     *
+     * @param restoredId persisted ID of the session
+     * @param sessionId  session ID
+     * @param now        current time in milliseconds
+     * @return session, or null if there is no live restored session with this persisted ID
+     */
+    Session claim(String restoredId, String sessionId, long now) {
+        int restoredIndex = segmentIndex(restoredId);
+        int claimedIndex = segmentIndex(sessionId);
+        Segment restoredSegment = segments[restoredIndex];
+        Segment claimedSegment = segments[claimedIndex];
+        Entry claimed;
+        // Segments are locked in index order, so concurrent claims can not deadlock
+        synchronized (segments[Math.min(restoredIndex, claimedIndex)]) {
+            synchronized (segments[Math.max(restoredIndex, claimedIndex)]) {
+                Entry entry = restoredSegment.entries.get(restoredId);
+                if (entry == null || !entry.restored || claimedSegment.entries.containsKey(sessionId)) {
+                    return null;
+                }
+                if (isExpired(entry, now)) {
+                    remove(restoredSegment, entry);
+                    return null;
+                }
+                restoredSegment.entries.remove(restoredId);
+                entry.removed = true;
+                unclaimedSessions.decrementAndGet();
+                unindex(sessionsByThingName, entry.thingName, entry);
+                unindex(sessionsByCertificateId, entry.certificateId, entry);
+
+                claimed = new Entry(sessionId, entry.session, entry.sessionKey, entry.createdMillis, now,
+                        entry.references, false);
+                claimedSegment.entries.put(sessionId, claimed);
+                index(sessionsByThingName, claimed.thingName, claimed);
+                index(sessionsByCertificateId, claimed.certificateId, claimed);
+                if (claimed.sessionKey != null) {
+                    // Sessions created since the restart are newer, so they stay the ones reused
+                    sessionsByKey.putIfAbsent(claimed.sessionKey, claimed);
+                }
+            }
+        }
+        // Queued out of creation order, which only delays expiry by lifetime until the session is next used
+        if (maxLifetimeMillis.getAsLong() > 0) {
+            synchronized (creationOrder) {
+                creationOrder.addLast(claimed);
+            }
+        }
+        return claimed.session;
+    }
+
+    boolean hasUnclaimedSessions() {
+        return unclaimedSessions.get() > 0;
+    }
+
+    private void put(Entry entry, long now, boolean notify) {
+        Segment segment = segmentFor(entry.sessionId);
+        synchronized (segment) {
+            Entry previous = segment.entries.put(entry.sessionId, entry);
+            if (previous == null) {
+                size.incrementAndGet();
+            } else {
+                onRemoved(previous);
+            }
+            index(sessionsByThingName, entry.thingName, entry);
+            index(sessionsByCertificateId, entry.certificateId, entry);
+            if (entry.restored) {
+                unclaimedSessions.incrementAndGet();
+            } else if (entry.sessionKey != null) {
+                // A concurrent authentication with the same credentials may have added a session meanwhile.
+                // The newest one is reused from now on, and the other stays valid until it is closed or expires.
+                sessionsByKey.put(entry.sessionKey, entry);
+            }
+            Listener l = listener;
+            if (notify && l != null) {
+                l.sessionPut(entry.sessionId, entry.session, entry.sessionKey, entry.createdMillis,
+                        entry.references);
+            }
+        }
+
+        synchronized (creationOrder) {
+            expireLifetime(now);
+            if (maxLifetimeMillis.getAsLong() > 0) {
+                creationOrder.addLast(entry);
+            }
+        }
+        for (Segment s : segments) {
+            synchronized (s) {
+                expireIdle(s, now);
+            }
+        }
+        while (size.get() > capacity.getAsInt()) {
+            if (!evictLeastRecentlyUsed()) {
+                break;
+            }
+        }
+    }
+
+    /**
+     * Drop a reference to a session, and remove the session once it has none left.
+     *
+     * @param sessionId session ID
+     */
+    void release(String sessionId) {
+        Segment segment = segmentFor(sessionId);
+        synchronized (segment) {
+            Entry entry = segment.entries.get(sessionId);
+            if (entry == null || entry.restored) {
+                return;
+            }
+            if (--entry.references <= 0) {
+                remove(segment, entry);
+                return;
+            }
+            Listener l = listener;
+            if (l != null) {
+                l.sessionReferencesChanged(sessionId, entry.references);
+            }
+        }
+    }
+
+    int size() {
+        return size.get();
+    }
+
+    /**
+     * Remove every session of a thing, regardless of its references.
+     *
+     * @param thingName thing name
+     * @return number of sessions removed
+     */
+    int invalidateByThingName(String thingName) {
+        return invalidate(sessionsByThingName, thingName);
+    }
+
+    /**
+     * Remove every session authenticated with a certificate, regardless of its references.
+     *
+     * @param certificateId IoT certificate ID
+     * @return number of sessions removed
+     */
+    int invalidateByCertificateId(String certificateId) {
+        return invalidate(sessionsByCertificateId, certificateId);
+    }
+
+    private int invalidate(Map<String, Set<Entry>> index, String indexKey) {
+        Set<Entry> entries = index.remove(indexKey);
+        if (entries == null) {
+            return 0;
+        }
+        // Sessions added meanwhile go to a new set, so this one is no longer modified
+        int removed = 0;
+        for (Entry entry : entries) {
+            Segment segment = segmentFor(entry.sessionId);
+            synchronized (segment) {
+                if (!entry.removed) {
+                    logger.atDebug().kv(SESSION_ID, entry.sessionId).log("Session invalidated. Closing session.");
+                    remove(segment, entry);
+                    removed++;
+                }
+            }
+        }
+        return removed;
+    }
+
+    private static void index(Map<String, Set<Entry>> index, String indexKey, Entry entry) {
+        if (indexKey == null) {
+            return;
+        }
+        index.compute(indexKey, (k, entries) -> {
+            Set<Entry> indexed = entries == null ? new HashSet<>(2) : entries;
+            indexed.add(entry);
+            return indexed;
+        });
+    }
+
+    private static void unindex(Map<String, Set<Entry>> index, String indexKey, Entry entry) {
+        if (indexKey == null) {
+            return;
+        }
+        index.computeIfPresent(indexKey, (k, entries) -> {
+            entries.remove(entry);
+            return entries.isEmpty() ? null : entries;
+        });
+    }
+
+    void setListener(Listener listener) {
+        this.listener = listener;
+    }
+
+    /**
+     * Report every live session to a consumer. Each segment is locked while its sessions are reported, so
+     * each change made meanwhile is reported to the listener either before its session is replayed or after.
+     *
+     * @param consumer session consumer
+     */
+    void replay(SessionConsumer consumer) {
+        for (Segment segment : segments) {
+            synchronized (segment) {
+                for (Entry entry : segment.entries.values()) {
+                    if (!entry.removed) {
+                        consumer.accept(entry.sessionId, entry.session, entry.sessionKey,
+                                entry.createdMillis, entry.references);
+                    }
+                }
+            }
+        }
+    }
+
+    private Segment segmentFor(String sessionId) {
+        return segments[segmentIndex(sessionId)];
+    }
+
+    private static int segmentIndex(String sessionId) {
+        int hash = sessionId.hashCode();
+        return (hash ^ (hash >>> 16)) & (SEGMENT_COUNT - 1);
+    }
+
+    private static void touch(Entry entry, long now) {
+        entry.lastAccessedMillis = now;
+        entry.lastAccessedNanos = System.nanoTime();
+    }
+
+    private boolean isExpired(Entry entry, long now) {
+        long idleTimeout = idleTimeoutMillis.getAsLong();
+        long maxLifetime = maxLifetimeMillis.getAsLong();
+        return (idleTimeout > 0 && now - entry.lastAccessedMillis >= idleTimeout)
+                || (maxLifetime > 0 && now - entry.createdMillis >= maxLifetime);
+    }
+
+    // Must hold the segment lock
+    private void expireIdle(Segment segment, long now) {
+        long idleTimeout = idleTimeoutMillis.getAsLong();
+        if (idleTimeout <= 0) {
+            return;
+        }
+        Iterator<Entry> leastRecentlyUsed = segment.entries.values().iterator();
+        while (leastRecentlyUsed.hasNext()) {
+            Entry entry = leastRecentlyUsed.next();
+            if (now - entry.lastAccessedMillis < idleTimeout) {
+                break;
+            }
+            logger.atDebug().kv(SESSION_ID, entry.sessionId).log("Session idle timeout. Closing session.");
+            leastRecentlyUsed.remove();
+            size.decrementAndGet();
+            onRemoved(entry);
+        }
+    }
+
+    // Must hold the creationOrder lock, and no segment lock
+    private void expireLifetime(long now) {
+        long maxLifetime = maxLifetimeMillis.getAsLong();
+        while (!creationOrder.isEmpty()) {
+            Entry entry = creationOrder.peekFirst();
+            if (!entry.removed && (maxLifetime <= 0 || now - entry.createdMillis < maxLifetime)) {
+                break;
+            }
+            creationOrder.removeFirst();
+            if (!entry.removed) {
+                logger.atDebug().kv(SESSION_ID, entry.sessionId).log("Session lifetime exceeded. Closing session.");
+                Segment segment = segmentFor(entry.sessionId);
+                synchronized (segment) {
+                    remove(segment, entry);
+                }
+            }
+        }
+    }
+
+    /**
+     * Evict the least recently used session, found among the segment heads.
+     *
+     * @return false if the cache is empty
+     */
+    private boolean evictLeastRecentlyUsed() {
+        Segment victimSegment = null;
+        Entry victim = null;
+        long victimLastAccessedNanos = 0;
+        for (Segment segment : segments) {
+            synchronized (segment) {
+                if (segment.entries.isEmpty()) {
+                    continue;
+                }
+                Entry head = segment.entries.values().iterator().next();
+                if (victim == null || head.lastAccessedNanos - victimLastAccessedNanos < 0) {
+                    victim = head;
+                    victimSegment = segment;
+                    victimLastAccessedNanos = head.lastAccessedNanos;
+                }
+            }
+        }
+        if (victim == null) {
+            return false;
+        }
+        synchronized (victimSegment) {
+            // Another thread may have used or removed the victim meanwhile, in which case the caller retries
+            if (!victim.removed && victimSegment.entries.values().iterator().next() == victim) {
+                logger.atTrace().kv(SESSION_ID, victim.sessionId)
+                        .log("Session Cache reached its capacity. Closing session.");
+                remove(victimSegment, victim);
+            }
+        }
+        return true;
+    }
+
+    // Must hold the segment lock
+    private void remove(Segment segment, Entry entry) {
+        if (segment.entries.remove(entry.sessionId, entry)) {
+            size.decrementAndGet();
+        }
+        onRemoved(entry);
+    }
+
+    private void onRemoved(Entry entry) {
+        if (entry.restored && !entry.removed) {
+            unclaimedSessions.decrementAndGet();
+        }
+        entry.removed = true;
+        if (entry.sessionKey != null) {
+            sessionsByKey.remove(entry.sessionKey, entry);
+        }
+        unindex(sessionsByThingName, entry.thingName, entry);
+        unindex(sessionsByCertificateId, entry.certificateId, entry);
+        Listener l = listener;
+        if (l != null) {
+            l.sessionRemoved(entry.sessionId);
+        }
+    }
+
+    @FunctionalInterface
+    interface SessionConsumer {
+        void accept(String sessionId, Session session, String sessionKey, long createdMillis, int references);
+    }
+
+    /**
+     * Receives session cache changes. Methods are called with a segment lock held, so they must not block
+     * or call back into the cache.
+     */
+    interface Listener {
+        void sessionPut(String sessionId, Session session, String sessionKey, long createdMillis, int references);
+
+        void sessionReferencesChanged(String sessionId, int references);
+
+        void sessionRemoved(String sessionId);
+    }
+
+    private static final class Segment {
+        // Access ordered, guarded by the segment
+        private final Map<String, Entry> entries = new LinkedHashMap<>(16, 0.75f, true);
+    }
+
+    private static final class Entry {
+        private final String sessionId;
+        private final Session session;
+        // Keyed by its persisted ID until claimed
+        private final boolean restored;
+        private final String sessionKey;
+        // Indexed identities, kept in case the session's attribute providers change
+        private final String thingName;
+        private final String certificateId;
+        private final long createdMillis;
+        // Guarded by the segment
+        private long lastAccessedMillis;
+        private long lastAccessedNanos;
+        private int references;
+        // Read without the segment lock when expiring by lifetime and looking up by session key
+        private volatile boolean removed;
+
+        Entry(String sessionId, Session session, String sessionKey, long createdMillis, long lastAccessedMillis,
+              int references, boolean restored) {
+            this.sessionId = sessionId;
+            this.session = session;
+            this.restored = restored;
+            this.sessionKey = sessionKey;
+            AttributeProvider thing = session.getAttributeProvider(Thing.NAMESPACE);
+            this.thingName = thing instanceof Thing ? ((Thing) thing).getThingName() : null;
+            AttributeProvider certificate = session.getAttributeProvider(Certificate.NAMESPACE);
+            this.certificateId = certificate instanceof Certificate
+                    ? ((Certificate) certificate).getIotCertificateId() : null;
+            this.createdMillis = createdMillis;
+            this.lastAccessedMillis = lastAccessedMillis;
+            this.lastAccessedNanos = System.nanoTime();
+            this.references = references;
+        }
+    }
+}
@@ -10,11 +10,18 @@ import com.aws.greengrass.logging.api.Logger;
 import com.aws.greengrass.logging.impl.LogManager;
 import com.aws.greengrass.util.Coerce;
 
+import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
 
 import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.DEFAULT_MAX_ACTIVE_AUTH_TOKENS;
 import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.MAX_ACTIVE_AUTH_TOKENS_TOPIC;
 import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.PERFORMANCE_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.PERSIST_SESSIONS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.SESSION_IDLE_TIMEOUT_SECONDS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.SESSION_MAX_LIFETIME_SECONDS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.SESSION_REUSE_MAX_AGE_SECONDS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.SIGNED_AUTH_TOKENS_TOPIC;
 
 @SuppressWarnings("PMD.DataClass")
 public class SessionConfig {
@@ -24,8 +31,17 @@ public class SessionConfig {
     // to be able to initialize and perform appropriate eviction check in LRU session cache
     public static final int MIN_SESSION_CAPACITY = 1;
     public static final int MAX_SESSION_CAPACITY = Integer.MAX_VALUE - 1;
+    // sessions do not expire by time unless a positive timeout is configured
+    public static final long NO_SESSION_TIMEOUT = 0L;
+    // a device reconnecting with identical credentials has them validated again at least this often
+    public static final long DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS = 300L;
 
     private final AtomicInteger sessionCapacity = new AtomicInteger(DEFAULT_SESSION_CAPACITY);
+    private final AtomicLong sessionIdleTimeoutSeconds = new AtomicLong(NO_SESSION_TIMEOUT);
+    private final AtomicLong sessionMaxLifetimeSeconds = new AtomicLong(NO_SESSION_TIMEOUT);
+    private final AtomicLong sessionReuseMaxAgeSeconds = new AtomicLong(DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS);
+    private final AtomicBoolean signedAuthTokens = new AtomicBoolean(false);
+    private final AtomicBoolean persistSessions = new AtomicBoolean(false);
 
     private final Topics configuration;
 
@@ -37,10 +53,20 @@ public class SessionConfig {
     public SessionConfig(Topics configuration) {
         this.configuration = configuration;
         this.sessionCapacity.set(getConfiguredSessionCapacity());
+        this.sessionIdleTimeoutSeconds.set(getConfiguredSessionTimeout(SESSION_IDLE_TIMEOUT_SECONDS_TOPIC));
+        this.sessionMaxLifetimeSeconds.set(getConfiguredSessionTimeout(SESSION_MAX_LIFETIME_SECONDS_TOPIC));
+        this.sessionReuseMaxAgeSeconds.set(getConfiguredSessionReuseMaxAge());
+        this.signedAuthTokens.set(getConfiguredBoolean(SIGNED_AUTH_TOKENS_TOPIC));
+        this.persistSessions.set(getConfiguredBoolean(PERSIST_SESSIONS_TOPIC));
 
         this.configuration.subscribe((whatHappened, node) -> {
-            // update session capacity to the latest configured value
+            // update session capacity, timeouts, token format and persistence to the latest configured values
             updateSessionCapacity(getConfiguredSessionCapacity());
+            sessionIdleTimeoutSeconds.set(getConfiguredSessionTimeout(SESSION_IDLE_TIMEOUT_SECONDS_TOPIC));
+            sessionMaxLifetimeSeconds.set(getConfiguredSessionTimeout(SESSION_MAX_LIFETIME_SECONDS_TOPIC));
+            sessionReuseMaxAgeSeconds.set(getConfiguredSessionReuseMaxAge());
+            signedAuthTokens.set(getConfiguredBoolean(SIGNED_AUTH_TOKENS_TOPIC));
+            persistSessions.set(getConfiguredBoolean(PERSIST_SESSIONS_TOPIC));
         });
     }
 
@@ -53,6 +79,57 @@ public class SessionConfig {
         return sessionCapacity.get();
     }
 
+    /**
+     * Get the time after which a session which has not been looked up expires.
+     *
+     * @return idle timeout in seconds, or {@link #NO_SESSION_TIMEOUT} if sessions never expire when idle
+     */
+    public long getSessionIdleTimeoutSeconds() {
+        return sessionIdleTimeoutSeconds.get();
+    }
+
+    /**
+     * Get the time after which a session expires, however recently it was looked up.
+     *
+     * @return maximum lifetime in seconds, or {@link #NO_SESSION_TIMEOUT} if sessions have no maximum lifetime
+     */
+    public long getSessionMaxLifetimeSeconds() {
+        return sessionMaxLifetimeSeconds.get();
+    }
+
+    /**
+     * Get the maximum age of a session which is reused for a client authenticating again with identical
+     * credentials. Older sessions are not reused, so the credentials are validated again, including the
+     * thing certificate association. This bounds how long a reconnecting device keeps getting valid tokens
+     * after its thing is detached or its certificate is deactivated.
+     *
+     * @return maximum session reuse age in seconds, or 0 if sessions are never reused
+     */
+    public long getSessionReuseMaxAgeSeconds() {
+        return sessionReuseMaxAgeSeconds.get();
+    }
+
+    /**
+     * Check whether auth tokens are signed, so that tokens which were not issued by this service can be
+     * rejected without looking them up. Enabling signed tokens invalidates unsigned tokens issued before.
+     *
+     * @return true if auth tokens are signed
+     */
+    public boolean isSignedAuthTokens() {
+        return signedAuthTokens.get();
+    }
+
+    /**
+     * Check whether sessions are persisted under the service work path, so that auth tokens stay valid when
+     * the service restarts. Changes take effect on the next service start. Auth tokens themselves are not
+     * persisted, only an HMAC of each, so the persisted sessions can not be used to impersonate devices.
+     *
+     * @return true if sessions are persisted
+     */
+    public boolean isPersistSessions() {
+        return persistSessions.get();
+    }
+
     /**
      * Updates Client-Device-Auth Session capacity to the desired int value.
      *
@@ -83,4 +160,50 @@ public class SessionConfig {
         }
         return configValue;
     }
+
+    /**
+     * Retrieves a configured session timeout.
+     * Negative values disable the timeout.
+     *
+     * @param topic timeout configuration topic under performance
+     * @return timeout in seconds, or {@link #NO_SESSION_TIMEOUT}
+     */
+    private long getConfiguredSessionTimeout(String topic) {
+        if (configuration == null || configuration.isEmpty()) {
+            return NO_SESSION_TIMEOUT;
+        }
+        long configValue = Coerce.toLong(configuration.findOrDefault(NO_SESSION_TIMEOUT, PERFORMANCE_TOPIC, topic));
+        if (configValue < 0) {
+            LOGGER.warn("Illegal value {} for configuration {}. Session timeout disabled", configValue, topic);
+            return NO_SESSION_TIMEOUT;
+        }
+        return configValue;
+    }
+
+    /**
+     * Retrieves the configured session reuse age.
+     * Negative values are replaced with the default.
+     *
+     * @return maximum session reuse age in seconds
+     */
+    private long getConfiguredSessionReuseMaxAge() {
+        if (configuration == null || configuration.isEmpty()) {
+            return DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS;
+        }
+        long configValue = Coerce.toLong(configuration.findOrDefault(DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS,
+                PERFORMANCE_TOPIC, SESSION_REUSE_MAX_AGE_SECONDS_TOPIC));
+        if (configValue < 0) {
+            LOGGER.warn("Illegal value {} for configuration {}. Using default value {}", configValue,
+                    SESSION_REUSE_MAX_AGE_SECONDS_TOPIC, DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS);
+            return DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS;
+        }
+        return configValue;
+    }
+
+    private boolean getConfiguredBoolean(String topic) {
+        if (configuration == null || configuration.isEmpty()) {
+            return false;
+        }
+        return Coerce.toBoolean(configuration.findOrDefault(false, PERFORMANCE_TOPIC, topic));
+    }
 }
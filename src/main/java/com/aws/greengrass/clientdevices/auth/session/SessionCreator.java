@@ -46,6 +46,23 @@ public class SessionCreator {
         return sessionFactory.createSession(credentialMap);
     }
 
+    /**
+     * Get a key identifying client device credentials, so that sessions can be reused when a client
+     * authenticates again with identical credentials.
+     *
+     * @param credentialType type of credentials provided
+     * @param credentialMap  map of client credentials
+     * @return session key, or null if sessions created from these credentials must not be reused
+     */
+    public static String getSessionKey(String credentialType, Map<String, String> credentialMap) {
+        SessionFactory sessionFactory = SessionFactorySingleton.INSTANCE.factoryMap.get(credentialType);
+        if (sessionFactory == null) {
+            return null;
+        }
+        String sessionKey = sessionFactory.getSessionKey(credentialMap);
+        return sessionKey == null ? null : credentialType + ':' + sessionKey;
+    }
+
     public static void registerSessionFactory(String credentialType, SessionFactory sessionFactory) {
         SessionFactorySingleton.INSTANCE.factoryMap.put(credentialType, sessionFactory);
     }
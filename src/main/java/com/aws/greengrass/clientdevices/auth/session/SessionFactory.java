@@ -11,4 +11,15 @@ import java.util.Map;
 
 public interface SessionFactory {
     Session createSession(Map<String, String> credentialMap) throws AuthenticationException;
+
+    /**
+     * Get a key identifying the given credentials, so that authenticating again with identical credentials
+     * can reuse the existing session instead of creating a new one.
+     *
+     * @param credentialMap map of client credentials
+     * @return session key, or null if sessions created from these credentials must not be reused
+     */
+    default String getSessionKey(Map<String, String> credentialMap) {
+        return null;
+    }
 }
@@ -9,6 +9,9 @@ import com.aws.greengrass.clientdevices.auth.iot.Certificate;
 import com.aws.greengrass.clientdevices.auth.session.attribute.AttributeProvider;
 import com.aws.greengrass.clientdevices.auth.session.attribute.DeviceAttribute;
 
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.Map;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.function.Function;
 
@@ -16,12 +19,18 @@ public class SessionImpl extends ConcurrentHashMap<String, AttributeProvider> im
 
     static final long serialVersionUID = -1L;
 
+    private final transient AuthorizationDecisionCache authorizationDecisionCache = new AuthorizationDecisionCache();
+    private transient volatile GroupMembership groupMembership;
+    // attribute namespace to attribute name to attribute, rebuilt whenever attribute providers change
+    private transient volatile Map<String, Map<String, DeviceAttribute>> attributeTable = Collections.emptyMap();
+
     // TODO: Replace this with Principal abstraction
     // so that a session can be instantiated using something else
     // e.g. username/password
     public SessionImpl(Certificate certificate) {
         super();
         this.put(certificate.getNamespace(), certificate);
+        onAttributesChanged();
     }
 
     @Override
@@ -32,14 +41,18 @@ public class SessionImpl extends ConcurrentHashMap<String, AttributeProvider> im
     @Override
     public AttributeProvider putAttributeProvider(String attributeProviderNameSpace,
                                                   AttributeProvider attributeProvider) {
-        return this.put(attributeProviderNameSpace, attributeProvider);
+        AttributeProvider previous = this.put(attributeProviderNameSpace, attributeProvider);
+        onAttributesChanged();
+        return previous;
     }
 
     @Override
     public AttributeProvider computeAttributeProviderIfAbsent(String attributeProviderNameSpace,
                                                               Function<? super String, ? extends AttributeProvider>
                                                                       mappingFunction) {
-        return computeIfAbsent(attributeProviderNameSpace, mappingFunction);
+        AttributeProvider provider = computeIfAbsent(attributeProviderNameSpace, mappingFunction);
+        onAttributesChanged();
+        return provider;
     }
 
     /**
@@ -51,9 +64,33 @@ public class SessionImpl extends ConcurrentHashMap<String, AttributeProvider> im
      */
     @Override
     public DeviceAttribute getSessionAttribute(String attributeNamespace, String attributeName) {
-        if (this.getAttributeProvider(attributeNamespace) != null) {
-            return this.getAttributeProvider(attributeNamespace).getDeviceAttributes().get(attributeName);
+        Map<String, DeviceAttribute> attributes = attributeTable.get(attributeNamespace);
+        return attributes == null ? null : attributes.get(attributeName);
+    }
+
+    @Override
+    public AuthorizationDecisionCache getAuthorizationDecisionCache() {
+        return authorizationDecisionCache;
+    }
+
+    // Group membership, and therefore every cached decision, depends on session attributes
+    private synchronized void onAttributesChanged() {
+        Map<String, Map<String, DeviceAttribute>> table = new HashMap<>();
+        for (Map.Entry<String, AttributeProvider> entry : entrySet()) {
+            table.put(entry.getKey(), entry.getValue().getDeviceAttributes());
         }
-        return null;
+        attributeTable = Collections.unmodifiableMap(table);
+        groupMembership = null;
+        authorizationDecisionCache.clear();
+    }
+
+    @Override
+    public GroupMembership getGroupMembership() {
+        return groupMembership;
+    }
+
+    @Override
+    public void setGroupMembership(GroupMembership groupMembership) {
+        this.groupMembership = groupMembership;
     }
 }
@@ -10,11 +10,14 @@ import com.aws.greengrass.logging.api.Logger;
 import com.aws.greengrass.logging.impl.LogManager;
 import lombok.AccessLevel;
 import lombok.Getter;
+import lombok.Setter;
 
-import java.util.Collections;
-import java.util.LinkedHashMap;
+import java.io.IOException;
+import java.time.Clock;
+import java.util.Arrays;
 import java.util.Map;
 import java.util.UUID;
+import java.util.concurrent.TimeUnit;
 
 /**
  * Singleton class for managing AuthN and AuthZ sessions.
@@ -23,25 +26,28 @@ public class SessionManager {
     private static final Logger logger = LogManager.getLogger(SessionManager.class);
     private static final String SESSION_ID = "SessionId";
 
-    // Thread-safe LRU Session Cache that evicts the eldest entry (based on access order) upon reaching its size.
-    // TODO: Support time-based cache eviction (Session timeout) and Session deduping.
+    // Thread-safe, bounded session cache which evicts approximately the least recently used session upon
+    // reaching its capacity, and expires sessions after the configured timeouts.
     @Getter(AccessLevel.PACKAGE)
-    private final Map<String, Session> sessionMap = Collections.synchronizedMap(
-            new LinkedHashMap<String, Session>(getSessionCapacity(), 0.75f, true) {
-                @Override
-                protected boolean removeEldestEntry(Map.Entry<String, Session> eldest) {
-                    // check size against latest configured session capacity
-                    if (size() > getSessionCapacity()) {
-                        logger.atTrace().kv(SESSION_ID, eldest.getKey())
-                                .log("Session Cache reached its capacity. Closing session.");
-                        return true;
-                    }
-                    return false;
-                }
-            });
+    private final SessionCache sessionCache = new SessionCache(this::getSessionCapacity,
+            this::getSessionIdleTimeoutMillis, this::getSessionMaxLifetimeMillis);
+
+    // Replaced by a signer with a persisted key when sessions are persisted
+    private volatile SessionTokenSigner tokenSigner = new SessionTokenSigner();
+
+    // Signers replaced while their tokens were live. Only consulted for tokens the current signer rejects.
+    private volatile SessionTokenSigner[] previousTokenSigners = new SessionTokenSigner[0];
+
+    // Store the live restored sessions were restored from, so that they can be claimed by their clients
+    private volatile SessionStore restoredFrom;
 
     private SessionConfig sessionConfig;
 
+    private SessionStore sessionStore;
+
+    @Setter(AccessLevel.PACKAGE)
+    private Clock clock = Clock.systemUTC();
+
     /**
      * Looks up a session by id.
      *
@@ -49,11 +55,22 @@ public class SessionManager {
      * @return session or null
      */
     public Session findSession(String sessionId) {
-        return sessionMap.get(sessionId);
+        // Reject forged and malformed tokens without touching the session cache
+        if (isSignedAuthTokens() && !verifyToken(sessionId)) {
+            return null;
+        }
+        long now = clock.millis();
+        Session session = sessionCache.get(sessionId, now);
+        if (session == null) {
+            session = claimRestoredSession(sessionId, now);
+        }
+        return session;
     }
 
     /**
-     * Creates a session with device credentials.
+     * Creates a session with device credentials. A live session created with identical credentials is
+     * reused instead, as long as it was created less than the configured session reuse age ago, so that
+     * devices which keep reconnecting still have their credentials validated at that interval.
      *
      * @param credentialType Device credential type
      * @param credentialMap  Device credential map
@@ -62,12 +79,19 @@ public class SessionManager {
      */
     public String createSession(String credentialType, Map<String, String> credentialMap)
             throws AuthenticationException {
+        String sessionKey = SessionCreator.getSessionKey(credentialType, credentialMap);
+        String sessionId = reuseSession(sessionKey);
+        if (sessionId != null) {
+            logger.atDebug().kv(SESSION_ID, sessionId).log("Reusing session for identical credentials");
+            return sessionId;
+        }
         Session session = SessionCreator.createSession(credentialType, credentialMap);
-        return addSessionInternal(session);
+        return addSessionInternal(session, sessionKey);
     }
 
     /**
-     * Closes a session.
+     * Closes a session. A session reused for identical credentials stays open until it has been closed
+     * once for each time it was handed out.
      *
      * @param sessionId session identifier
      */
@@ -76,6 +100,32 @@ public class SessionManager {
         closeSessionInternal(sessionId);
     }
 
+    /**
+     * Closes every session of a thing, e.g. once it has been deleted or detached from its certificate.
+     * Clients of the closed sessions must authenticate again.
+     *
+     * @param thingName thing name
+     * @return number of sessions closed
+     */
+    public int invalidateSessionsForThing(String thingName) {
+        int invalidated = sessionCache.invalidateByThingName(thingName);
+        logger.atInfo().kv("thingName", thingName).kv("sessions", invalidated).log("Invalidated sessions");
+        return invalidated;
+    }
+
+    /**
+     * Closes every session authenticated with a certificate, e.g. once it has been deactivated or revoked.
+     * Clients of the closed sessions must authenticate again.
+     *
+     * @param certificateId IoT certificate ID
+     * @return number of sessions closed
+     */
+    public int invalidateSessionsForCertificate(String certificateId) {
+        int invalidated = sessionCache.invalidateByCertificateId(certificateId);
+        logger.atInfo().kv("certificateId", certificateId).kv("sessions", invalidated).log("Invalidated sessions");
+        return invalidated;
+    }
+
     /**
      * Session configuration setter.
      *
@@ -85,23 +135,124 @@ public class SessionManager {
         this.sessionConfig = sessionConfig;
     }
 
-    private synchronized void closeSessionInternal(String sessionId) {
-        sessionMap.remove(sessionId);
+    /**
+     * Restore the sessions persisted by a previous run, then persist session changes until
+     * {@link #stopPersistence()}. Live sessions are kept, and their signed tokens stay valid.
+     *
+     * @param store session store
+     * @throws IOException if the session store can not be opened
+     */
+    public synchronized void startPersistence(SessionStore store) throws IOException {
+        stopPersistence();
+        // Signed tokens issued by the previous run must stay valid
+        byte[] tokenKey = store.getTokenKey();
+        if (!tokenSigner.hasKey(tokenKey)) {
+            SessionTokenSigner[] signers = Arrays.copyOf(previousTokenSigners, previousTokenSigners.length + 1);
+            signers[signers.length - 1] = tokenSigner;
+            previousTokenSigners = signers;
+            tokenSigner = new SessionTokenSigner(tokenKey);
+        }
+        store.open(sessionCache, clock.millis());
+        sessionStore = store;
+        restoredFrom = store;
+    }
+
+    /**
+     * Write pending session changes and stop persisting sessions.
+     */
+    public synchronized void stopPersistence() {
+        if (sessionStore != null) {
+            sessionStore.close();
+            sessionStore = null;
+        }
+    }
+
+    /**
+     * Stop persisting sessions and delete the sessions persisted by a previous run. Called when persistence
+     * is disabled, so that enabling it later does not restore sessions which were closed, invalidated or
+     * revoked in the meantime.
+     *
+     * @param store session store
+     * @throws IOException if the persisted sessions can not be deleted
+     */
+    public synchronized void discardPersistedSessions(SessionStore store) throws IOException {
+        stopPersistence();
+        store.delete();
+    }
+
+    private void closeSessionInternal(String sessionId) {
+        if (!sessionCache.containsKey(sessionId)) {
+            claimRestoredSession(sessionId, clock.millis());
+        }
+        sessionCache.release(sessionId);
+    }
+
+    private boolean verifyToken(String sessionId) {
+        if (tokenSigner.verify(sessionId)) {
+            return true;
+        }
+        for (SessionTokenSigner signer : previousTokenSigners) {
+            if (signer.verify(sessionId)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Restored sessions are keyed by their persisted ID until their client presents the session ID
+    private Session claimRestoredSession(String sessionId, long now) {
+        SessionStore store = restoredFrom;
+        if (store == null || !sessionCache.hasUnclaimedSessions()) {
+            return null;
+        }
+        String restoredId = store.restoredIdFor(sessionId);
+        if (restoredId == null) {
+            return null;
+        }
+        Session session = sessionCache.claim(restoredId, sessionId, now);
+        // A concurrent lookup of the same session may have claimed it first
+        return session == null ? sessionCache.get(sessionId, now) : session;
+    }
+
+    // Returns the ID of a live session with the given key, or null if there is none
+    private String reuseSession(String sessionKey) {
+        if (sessionKey == null) {
+            return null;
+        }
+        long maxAgeMillis = getSessionReuseMaxAgeMillis();
+        if (maxAgeMillis == 0) {
+            return null;
+        }
+        return sessionCache.reuse(sessionKey, clock.millis(), maxAgeMillis);
     }
 
     // Returns a session ID which can be returned to the client
-    private synchronized String addSessionInternal(Session session) {
+    private String addSessionInternal(Session session, String sessionKey) {
         String sessionId = generateSessionId();
         logger.atDebug().kv(SESSION_ID, sessionId).log("Creating new session");
-        sessionMap.put(sessionId, session);
+        sessionCache.put(sessionId, session, sessionKey, clock.millis());
         return sessionId;
     }
 
+    /**
+     * Register a session under a fixed id, bypassing credential validation.
+     *
+     * @param sessionId session id
+     * @param session   session
+     */
+    void putSession(String sessionId, Session session) {
+        sessionCache.put(sessionId, session, null, clock.millis());
+    }
+
     private String generateSessionId() {
+        if (isSignedAuthTokens()) {
+            // 128 random bits, which do not collide in practice
+            return tokenSigner.mint();
+        }
         String sessionId;
         do {
             sessionId = UUID.randomUUID().toString();
-        } while (sessionMap.containsKey(sessionId));
+        } while (sessionCache.containsKey(sessionId));
         return sessionId;
     }
 
@@ -111,4 +262,29 @@ public class SessionManager {
         }
         return sessionConfig.getSessionCapacity();
     }
+
+    private boolean isSignedAuthTokens() {
+        return sessionConfig != null && sessionConfig.isSignedAuthTokens();
+    }
+
+    private long getSessionIdleTimeoutMillis() {
+        if (sessionConfig == null) {
+            return SessionConfig.NO_SESSION_TIMEOUT;
+        }
+        return TimeUnit.SECONDS.toMillis(sessionConfig.getSessionIdleTimeoutSeconds());
+    }
+
+    private long getSessionReuseMaxAgeMillis() {
+        if (sessionConfig == null) {
+            return TimeUnit.SECONDS.toMillis(SessionConfig.DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS);
+        }
+        return TimeUnit.SECONDS.toMillis(sessionConfig.getSessionReuseMaxAgeSeconds());
+    }
+
+    private long getSessionMaxLifetimeMillis() {
+        if (sessionConfig == null) {
+            return SessionConfig.NO_SESSION_TIMEOUT;
+        }
+        return TimeUnit.SECONDS.toMillis(sessionConfig.getSessionMaxLifetimeSeconds());
+    }
 }
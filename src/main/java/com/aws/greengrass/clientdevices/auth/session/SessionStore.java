@@ -0,0 +1,585 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService;
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Component;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.attribute.AttributeProvider;
+import com.aws.greengrass.lifecyclemanager.Kernel;
+import com.aws.greengrass.logging.api.Logger;
+import com.aws.greengrass.logging.impl.LogManager;
+import com.aws.greengrass.util.FileSystemPermission;
+import com.aws.greengrass.util.platforms.Platform;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.EOFException;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.security.GeneralSecurityException;
+import java.security.MessageDigest;
+import java.security.SecureRandom;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Base64;
+import java.util.Comparator;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Queue;
+import java.util.Set;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.ScheduledFuture;
+import java.util.concurrent.TimeUnit;
+import javax.crypto.Mac;
+import javax.crypto.spec.SecretKeySpec;
+import javax.inject.Inject;
+
+/**
+ * Persists sessions under the service work path, so that auth tokens stay valid when the service restarts.
+ *
+ * <p>Session changes are appended to a log by a periodic flush, so sessions are never written from the
+ * authentication path. Each record is authenticated with an HMAC chained over the previous record, so a
+ * corrupt, truncated or tampered log is replayed only up to its last intact record. Once the log holds
+ * more records than twice the number of live sessions, it is compacted by writing the live sessions to a
+ * new log which atomically replaces the old one.</p>
+ *
+ * <p>Session IDs are auth tokens, so the log holds an HMAC of each session ID instead. Restored sessions are
+ * keyed by that HMAC until their client presents its token, see {@link #restoredIdFor(String)}.</p>
+ *
+ * <p>The log and token keys are stored next to the log, readable only by the owner.</p>
+ */
+public class SessionStore {
+    private static final Logger logger = LogManager.getLogger(SessionStore.class);
+    static final String SESSION_LOG_FILENAME = "sessions.log";
+    static final String SESSION_KEY_FILENAME = "sessions.key";
+    private static final String COMPACTED_LOG_FILENAME = "sessions.log.new";
+    private static final FileSystemPermission OWNER_RW_ONLY = FileSystemPermission.builder()
+            .ownerRead(true).ownerWrite(true).build();
+
+    private static final int LOG_MAGIC = 0x43444153;
+    // Version 1 logs held plain session IDs
+    private static final int LOG_VERSION = 2;
+    private static final int LOG_ID_LENGTH = 16;
+    private static final int MAX_RECORD_LENGTH = 64 * 1024;
+    private static final String MAC_ALGORITHM = "HmacSHA256";
+    private static final int LOG_KEY_LENGTH = 32;
+    static final int MIN_COMPACTION_RECORDS = 1000;
+    private static final long FLUSH_INTERVAL_MILLIS = 1000;
+    // Never starts a session ID, which is either a UUID or a signed token
+    private static final String PERSISTED_ID_PREFIX = "#";
+
+    private static final byte PUT_RECORD = 1;
+    private static final byte REFERENCES_RECORD = 2;
+    private static final byte REMOVE_RECORD = 3;
+    private static final byte NO_PRINCIPAL = 0;
+    private static final byte THING_PRINCIPAL = 1;
+    private static final byte COMPONENT_PRINCIPAL = 2;
+
+    private final Path workPath;
+    private final ScheduledExecutorService ses;
+    private final Platform platform = Platform.getInstance();
+
+    // Encoded records not yet written, in the order the session cache reported them
+    private final Queue<byte[]> pendingRecords = new ConcurrentLinkedQueue<>();
+    private final SessionCache.Listener recorder = new Recorder();
+    // Read by the recorder without holding the lock
+    private volatile SessionIdHasher idHasher;
+
+    // Guarded by this
+    private byte[] logKey;
+    private byte[] tokenKey;
+    private Mac logMac;
+    private byte[] chainMac;
+    private FileOutputStream logFile;
+    private DataOutputStream log;
+    private int recordsSinceCompaction;
+    private boolean compactionRequired;
+    private SessionCache sessionCache;
+    private ScheduledFuture<?> flushFuture;
+
+    @Inject
+    public SessionStore(Kernel kernel, ScheduledExecutorService ses) throws IOException {
+        this(kernel.getNucleusPaths().workPath(ClientDevicesAuthService.CLIENT_DEVICES_AUTH_SERVICE_NAME), ses);
+    }
+
+    // For unit tests
+    SessionStore(Path workPath, ScheduledExecutorService ses) {
+        this.workPath = workPath;
+        this.ses = ses;
+    }
+
+    /**
+     * Get the key signing session tokens, so that signed tokens stay valid across restarts.
+     *
+     * @return token signing key
+     * @throws IOException if the key can neither be loaded nor created
+     */
+    synchronized byte[] getTokenKey() throws IOException {
+        loadKeys();
+        return tokenKey.clone();
+    }
+
+    /**
+     * Get the ID a session was restored under, so that the session can be claimed by the client holding its
+     * session ID.
+     *
+     * @param sessionId session ID
+     * @return restored session ID, or null if no session can have been restored under this session ID
+     */
+    String restoredIdFor(String sessionId) {
+        SessionIdHasher hasher = idHasher;
+        if (hasher == null || sessionId.startsWith(PERSISTED_ID_PREFIX)) {
+            return null;
+        }
+        return hasher.hash(sessionId);
+    }
+
+    /**
+     * Restore the persisted sessions into a session cache, then persist the cache's changes until closed.
+     *
+     * @param cache session cache
+     * @param now   current time in milliseconds
+     * @throws IOException if the log can not be written
+     */
+    synchronized void open(SessionCache cache, long now) throws IOException {
+        loadKeys();
+        List<PersistedSession> sessions = readLog();
+        sessions.sort(Comparator.comparingLong(session -> session.createdMillis));
+        // Live sessions are kept, and are only known to the cache by their session ID
+        Set<String> liveIds = new HashSet<>();
+        cache.replay((sessionId, session, sessionKey, createdMillis, references) ->
+                liveIds.add(persistedId(sessionId)));
+        for (PersistedSession session : sessions) {
+            if (liveIds.contains(session.persistedId)) {
+                continue;
+            }
+            cache.restore(session.persistedId, session.session, session.sessionKey, session.createdMillis,
+                    session.references, now);
+        }
+        logger.atInfo().kv("restoredSessions", cache.size()).log("Restored persisted sessions");
+
+        this.sessionCache = cache;
+        cache.setListener(recorder);
+        try {
+            // Start a new log, which drops any corrupt tail of the previous one
+            compact();
+        } catch (IOException e) {
+            cache.setListener(null);
+            closeLog();
+            sessionCache = null;
+            pendingRecords.clear();
+            throw e;
+        }
+        flushFuture = ses.scheduleWithFixedDelay(this::flush, FLUSH_INTERVAL_MILLIS, FLUSH_INTERVAL_MILLIS,
+                TimeUnit.MILLISECONDS);
+    }
+
+    /**
+     * Write pending changes and stop persisting sessions.
+     */
+    synchronized void close() {
+        if (sessionCache == null) {
+            return;
+        }
+        sessionCache.setListener(null);
+        if (flushFuture != null) {
+            flushFuture.cancel(false);
+            flushFuture = null;
+        }
+        flush();
+        closeLog();
+        sessionCache = null;
+        pendingRecords.clear();
+    }
+
+    /**
+     * Stop persisting sessions and delete the persisted sessions and keys, so that sessions closed while
+     * persistence is disabled are never restored by a later run.
+     *
+     * @throws IOException if the files can not be deleted
+     */
+    synchronized void delete() throws IOException {
+        close();
+        logKey = null;
+        tokenKey = null;
+        logMac = null;
+        idHasher = null;
+        Files.deleteIfExists(workPath.resolve(SESSION_LOG_FILENAME));
+        Files.deleteIfExists(workPath.resolve(COMPACTED_LOG_FILENAME));
+        Files.deleteIfExists(workPath.resolve(SESSION_KEY_FILENAME));
+    }
+
+    /**
+     * Append pending changes to the log, and compact it once it has grown large enough.
+     */
+    synchronized void flush() {
+        if (sessionCache == null) {
+            return;
+        }
+        try {
+            if (compactionRequired) {
+                pendingRecords.clear();
+                compact();
+                return;
+            }
+            boolean written = false;
+            byte[] record;
+            while ((record = pendingRecords.poll()) != null) {
+                append(record);
+                written = true;
+            }
+            if (written) {
+                log.flush();
+                logFile.getChannel().force(false);
+            }
+            if (recordsSinceCompaction > Math.max(MIN_COMPACTION_RECORDS, 2 * sessionCache.size())) {
+                compact();
+            }
+        } catch (IOException e) {
+            // Every live session is rewritten by the next compaction, so pending changes can be dropped
+            logger.atWarn().cause(e).log("Unable to persist sessions. Retrying on next flush");
+            pendingRecords.clear();
+            compactionRequired = true;
+        }
+    }
+
+    // Writes the live sessions to a new log which replaces the current one. Changes reported while the cache
+    // is replayed stay pending, and are appended to the new log afterwards.
+    private void compact() throws IOException {
+        closeLog();
+        Path compactedPath = workPath.resolve(COMPACTED_LOG_FILENAME);
+        openLog(compactedPath, false);
+        List<byte[]> records = new ArrayList<>();
+        sessionCache.replay((sessionId, session, sessionKey, createdMillis, references) -> {
+            byte[] record = encodePut(persistedId(sessionId), session, sessionKey, createdMillis, references);
+            if (record != null) {
+                records.add(record);
+            }
+        });
+        for (byte[] record : records) {
+            append(record);
+        }
+        log.flush();
+        logFile.getChannel().force(false);
+        closeLog();
+
+        Path logPath = workPath.resolve(SESSION_LOG_FILENAME);
+        Files.move(compactedPath, logPath, StandardCopyOption.ATOMIC_MOVE, StandardCopyOption.REPLACE_EXISTING);
+        openLog(logPath, true);
+        recordsSinceCompaction = 0;
+        compactionRequired = false;
+        logger.atDebug().kv("persistedSessions", records.size()).log("Compacted session log");
+    }
+
+    private void openLog(Path path, boolean append) throws IOException {
+        Files.createDirectories(path.getParent());
+        logFile = new FileOutputStream(path.toFile(), append);
+        log = new DataOutputStream(new BufferedOutputStream(logFile));
+        if (!append) {
+            platform.setPermissions(OWNER_RW_ONLY, path);
+            byte[] logId = new byte[LOG_ID_LENGTH];
+            new SecureRandom().nextBytes(logId);
+            byte[] header = encodeHeader(logId);
+            log.write(header);
+            chainMac = logMac.doFinal(header);
+        }
+    }
+
+    private void closeLog() {
+        if (log == null) {
+            return;
+        }
+        try {
+            log.close();
+        } catch (IOException e) {
+            logger.atWarn().cause(e).log("Unable to close session log");
+        }
+        log = null;
+        logFile = null;
+    }
+
+    private void append(byte[] record) throws IOException {
+        logMac.update(chainMac);
+        chainMac = logMac.doFinal(record);
+        log.writeInt(record.length);
+        log.write(record);
+        log.write(chainMac);
+        recordsSinceCompaction++;
+    }
+
+    /**
+     * Replay the log up to its last intact record.
+     *
+     * @return live sessions
+     */
+    private List<PersistedSession> readLog() {
+        Map<String, PersistedSession> sessions = new HashMap<>();
+        Path logPath = workPath.resolve(SESSION_LOG_FILENAME);
+        if (!Files.exists(logPath)) {
+            return new ArrayList<>();
+        }
+        try (DataInputStream in = new DataInputStream(new BufferedInputStream(Files.newInputStream(logPath)))) {
+            if (in.readInt() != LOG_MAGIC || in.readInt() != LOG_VERSION) {
+                logger.atWarn().log("Unrecognized session log. Persisted sessions are discarded");
+                return new ArrayList<>();
+            }
+            byte[] logId = new byte[LOG_ID_LENGTH];
+            in.readFully(logId);
+            byte[] chain = logMac.doFinal(encodeHeader(logId));
+            while (true) {
+                int length;
+                try {
+                    length = in.readInt();
+                } catch (EOFException e) {
+                    break;
+                }
+                if (length <= 0 || length > MAX_RECORD_LENGTH) {
+                    logger.atWarn().log("Session log is corrupt. Later sessions are discarded");
+                    break;
+                }
+                byte[] record = new byte[length];
+                in.readFully(record);
+                byte[] recordMac = new byte[chain.length];
+                in.readFully(recordMac);
+                logMac.update(chain);
+                chain = logMac.doFinal(record);
+                if (!MessageDigest.isEqual(chain, recordMac)) {
+                    logger.atWarn().log("Session log failed its integrity check. Later sessions are discarded");
+                    break;
+                }
+                applyRecord(record, sessions);
+            }
+        } catch (EOFException e) {
+            // The service stopped while appending the last record
+            logger.atDebug().log("Session log ends with an incomplete record");
+        } catch (IOException | IllegalArgumentException e) {
+            logger.atWarn().cause(e).log("Unable to read session log. Later sessions are discarded");
+        }
+        return new ArrayList<>(sessions.values());
+    }
+
+    private static void applyRecord(byte[] record, Map<String, PersistedSession> sessions) throws IOException {
+        DataInputStream in = new DataInputStream(new ByteArrayInputStream(record));
+        byte type = in.readByte();
+        String persistedId = in.readUTF();
+        switch (type) {
+            case PUT_RECORD:
+                sessions.put(persistedId, decodePut(persistedId, in));
+                break;
+            case REFERENCES_RECORD:
+                PersistedSession session = sessions.get(persistedId);
+                if (session != null) {
+                    session.references = in.readInt();
+                }
+                break;
+            case REMOVE_RECORD:
+                sessions.remove(persistedId);
+                break;
+            default:
+                throw new IOException("Unknown session log record type " + type);
+        }
+    }
+
+    private static byte[] encodeHeader(byte[] logId) {
+        ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        try (DataOutputStream out = new DataOutputStream(bytes)) {
+            out.writeInt(LOG_MAGIC);
+            out.writeInt(LOG_VERSION);
+            out.write(logId);
+        } catch (IOException e) {
+            // Not thrown when writing to memory
+            throw new IllegalStateException(e);
+        }
+        return bytes.toByteArray();
+    }
+
+    /**
+     * Encode a session. Only sessions of MQTT clients can be encoded.
+     *
+     * @return record, or null if the session can not be persisted
+     */
+    private static byte[] encodePut(String persistedId, Session session, String sessionKey, long createdMillis,
+                                    int references) {
+        AttributeProvider certificate = session.getAttributeProvider(Certificate.NAMESPACE);
+        if (!(certificate instanceof Certificate)) {
+            return null;
+        }
+        AttributeProvider thing = session.getAttributeProvider(Thing.NAMESPACE);
+        ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        try (DataOutputStream out = new DataOutputStream(bytes)) {
+            out.writeByte(PUT_RECORD);
+            out.writeUTF(persistedId);
+            out.writeBoolean(sessionKey != null);
+            if (sessionKey != null) {
+                out.writeUTF(sessionKey);
+            }
+            out.writeLong(createdMillis);
+            out.writeInt(references);
+            out.writeUTF(((Certificate) certificate).getIotCertificateId());
+            if (thing instanceof Thing) {
+                out.writeByte(THING_PRINCIPAL);
+                out.writeUTF(((Thing) thing).getThingName());
+            } else if (session.getAttributeProvider(Component.NAMESPACE) instanceof Component) {
+                out.writeByte(COMPONENT_PRINCIPAL);
+            } else {
+                out.writeByte(NO_PRINCIPAL);
+            }
+        } catch (IOException e) {
+            // Not thrown when writing to memory
+            throw new IllegalStateException(e);
+        }
+        return bytes.toByteArray();
+    }
+
+    private static PersistedSession decodePut(String persistedId, DataInputStream in) throws IOException {
+        String sessionKey = in.readBoolean() ? in.readUTF() : null;
+        long createdMillis = in.readLong();
+        int references = in.readInt();
+        Certificate certificate = new Certificate(in.readUTF());
+        byte principal = in.readByte();
+        Thing thing = principal == THING_PRINCIPAL ? new Thing(in.readUTF()) : null;
+        Session session = new CompactSession(certificate, thing, principal == COMPONENT_PRINCIPAL);
+        return new PersistedSession(persistedId, session, sessionKey, createdMillis, references);
+    }
+
+    private static byte[] encodeUpdate(byte type, String persistedId, int references) {
+        ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        try (DataOutputStream out = new DataOutputStream(bytes)) {
+            out.writeByte(type);
+            out.writeUTF(persistedId);
+            if (type == REFERENCES_RECORD) {
+                out.writeInt(references);
+            }
+        } catch (IOException e) {
+            // Not thrown when writing to memory
+            throw new IllegalStateException(e);
+        }
+        return bytes.toByteArray();
+    }
+
+    // Loads the log and token keys, or creates them on first use
+    private void loadKeys() throws IOException {
+        if (logKey != null) {
+            return;
+        }
+        Path keyPath = workPath.resolve(SESSION_KEY_FILENAME);
+        byte[] keys = null;
+        if (Files.exists(keyPath)) {
+            keys = Files.readAllBytes(keyPath);
+            if (keys.length != LOG_KEY_LENGTH + SessionTokenSigner.KEY_LENGTH) {
+                logger.atWarn().log("Session key is corrupt. Persisted sessions are discarded");
+                keys = null;
+            }
+        }
+        if (keys == null) {
+            keys = new byte[LOG_KEY_LENGTH + SessionTokenSigner.KEY_LENGTH];
+            new SecureRandom().nextBytes(keys);
+            Files.createDirectories(keyPath.getParent());
+            Files.deleteIfExists(workPath.resolve(SESSION_LOG_FILENAME));
+            try (OutputStream out = Files.newOutputStream(keyPath)) {
+                platform.setPermissions(OWNER_RW_ONLY, keyPath);
+                out.write(keys);
+            }
+        }
+        logKey = Arrays.copyOfRange(keys, 0, LOG_KEY_LENGTH);
+        tokenKey = Arrays.copyOfRange(keys, LOG_KEY_LENGTH, keys.length);
+        try {
+            logMac = Mac.getInstance(MAC_ALGORITHM);
+            logMac.init(new SecretKeySpec(logKey, MAC_ALGORITHM));
+        } catch (GeneralSecurityException e) {
+            // HmacSHA256 is required of every Java platform
+            throw new IllegalStateException("Unable to initialize session log MAC", e);
+        }
+        idHasher = new SessionIdHasher(logKey);
+    }
+
+    // Sessions which were restored and not claimed yet keep their persisted ID
+    private String persistedId(String sessionId) {
+        if (sessionId.startsWith(PERSISTED_ID_PREFIX)) {
+            return sessionId;
+        }
+        return idHasher.hash(sessionId);
+    }
+
+    // Called by the session cache with a segment lock held, so records are only queued
+    private class Recorder implements SessionCache.Listener {
+        @Override
+        public void sessionPut(String sessionId, Session session, String sessionKey, long createdMillis,
+                               int references) {
+            byte[] record = encodePut(persistedId(sessionId), session, sessionKey, createdMillis, references);
+            if (record != null) {
+                pendingRecords.add(record);
+            }
+        }
+
+        @Override
+        public void sessionReferencesChanged(String sessionId, int references) {
+            pendingRecords.add(encodeUpdate(REFERENCES_RECORD, persistedId(sessionId), references));
+        }
+
+        @Override
+        public void sessionRemoved(String sessionId) {
+            pendingRecords.add(encodeUpdate(REMOVE_RECORD, persistedId(sessionId), 0));
+        }
+    }
+
+    // Hashes session IDs for the recorder and for lookups, so each thread has its own MAC
+    private static final class SessionIdHasher {
+        private final SecretKeySpec key;
+        private final ThreadLocal<Mac> mac = ThreadLocal.withInitial(this::newMac);
+
+        SessionIdHasher(byte[] key) {
+            this.key = new SecretKeySpec(key, MAC_ALGORITHM);
+        }
+
+        String hash(String sessionId) {
+            byte[] digest = mac.get().doFinal(sessionId.getBytes(StandardCharsets.UTF_8));
+            return PERSISTED_ID_PREFIX + Base64.getUrlEncoder().withoutPadding().encodeToString(digest);
+        }
+
+        private Mac newMac() {
+            try {
+                Mac idMac = Mac.getInstance(MAC_ALGORITHM);
+                idMac.init(key);
+                return idMac;
+            } catch (GeneralSecurityException e) {
+                // HmacSHA256 is required of every Java platform
+                throw new IllegalStateException("Unable to initialize session ID MAC", e);
+            }
+        }
+    }
+
+    private static final class PersistedSession {
+        private final String persistedId;
+        private final Session session;
+        private final String sessionKey;
+        private final long createdMillis;
+        private int references;
+
+        PersistedSession(String persistedId, Session session, String sessionKey, long createdMillis,
+                         int references) {
+            this.persistedId = persistedId;
+            this.session = session;
+            this.sessionKey = sessionKey;
+            this.createdMillis = createdMillis;
+            this.references = references;
+        }
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import java.nio.charset.StandardCharsets;
+import java.security.GeneralSecurityException;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.security.SecureRandom;
+import java.util.Base64;
+import javax.crypto.Mac;
+import javax.crypto.spec.SecretKeySpec;
+
+/**
+ * Mints and verifies self-validating session tokens.
+ *
+ * <p>A token is {@code s1.} followed by the unpadded base64url encoding of 16 random bytes and the first 16
+ * bytes of their HMAC-SHA256 under the signer's key. Verification recomputes the HMAC and compares it in
+ * constant time.</p>
+ */
+final class SessionTokenSigner {
+    static final String TOKEN_PREFIX = "s1.";
+    private static final String MAC_ALGORITHM = "HmacSHA256";
+    static final int KEY_LENGTH = 32;
+    private static final int RANDOM_LENGTH = 16;
+    private static final int MAC_LENGTH = 16;
+    private static final int TOKEN_LENGTH =
+            TOKEN_PREFIX.length() + (4 * (RANDOM_LENGTH + MAC_LENGTH) + 2) / 3;
+    private static final String RANDOM_ALGORITHM = "SHA1PRNG";
+    private static final int SEED_LENGTH = 32;
+    // Only used to seed the per-thread generators
+    private static final SecureRandom SEED_SOURCE = new SecureRandom();
+
+    private final SecretKeySpec key;
+    // Per thread, since the default NativePRNG instances share a lock
+    private final ThreadLocal<SecureRandom> random = ThreadLocal.withInitial(SessionTokenSigner::newRandom);
+    private final ThreadLocal<Mac> mac = ThreadLocal.withInitial(this::newMac);
+
+    SessionTokenSigner() {
+        this(generateKey());
+    }
+
+    /**
+     * Constructor for a signer whose tokens stay valid across restarts.
+     *
+     * @param key signing key of {@link #KEY_LENGTH} bytes
+     */
+    SessionTokenSigner(byte[] key) {
+        if (key.length != KEY_LENGTH) {
+            throw new IllegalArgumentException("Session token key must be " + KEY_LENGTH + " bytes");
+        }
+        this.key = new SecretKeySpec(key, MAC_ALGORITHM);
+    }
+
+    /**
+     * Check whether this signer signs with a key.
+     *
+     * @param otherKey signing key
+     * @return true if the signer's key equals the given key
+     */
+    boolean hasKey(byte[] otherKey) {
+        return MessageDigest.isEqual(key.getEncoded(), otherKey);
+    }
+
+    static byte[] generateKey() {
+        byte[] key = new byte[KEY_LENGTH];
+        new SecureRandom().nextBytes(key);
+        return key;
+    }
+
+    /**
+     * Mint a new token.
+     *
+     * @return session token
+     */
+    String mint() {
+        byte[] token = new byte[RANDOM_LENGTH + MAC_LENGTH];
+        random.get().nextBytes(token);
+        byte[] signature = sign(token);
+        System.arraycopy(signature, 0, token, RANDOM_LENGTH, MAC_LENGTH);
+        return TOKEN_PREFIX + Base64.getUrlEncoder().withoutPadding().encodeToString(token);
+    }
+
+    /**
+     * Verify that a token was minted by this signer. The signature is compared in constant time.
+     *
+     * @param token session token
+     * @return true if the token is well-formed and correctly signed
+     */
+    boolean verify(String token) {
+        if (token == null || token.length() != TOKEN_LENGTH || !token.startsWith(TOKEN_PREFIX)) {
+            return false;
+        }
+        byte[] decoded;
+        try {
+            decoded = Base64.getUrlDecoder().decode(
+                    token.substring(TOKEN_PREFIX.length()).getBytes(StandardCharsets.US_ASCII));
+        } catch (IllegalArgumentException e) {
+            return false;
+        }
+        if (decoded.length != RANDOM_LENGTH + MAC_LENGTH) {
+            return false;
+        }
+        byte[] signature = sign(decoded);
+        int difference = 0;
+        for (int i = 0; i < MAC_LENGTH; i++) {
+            difference |= signature[i] ^ decoded[RANDOM_LENGTH + i];
+        }
+        return difference == 0;
+    }
+
+    // Signs the random part of the token
+    private byte[] sign(byte[] token) {
+        Mac tokenMac = mac.get();
+        tokenMac.update(token, 0, RANDOM_LENGTH);
+        return tokenMac.doFinal();
+    }
+
+    private static SecureRandom newRandom() {
+        byte[] seed = new byte[SEED_LENGTH];
+        SEED_SOURCE.nextBytes(seed);
+        SecureRandom threadRandom;
+        try {
+            threadRandom = SecureRandom.getInstance(RANDOM_ALGORITHM);
+        } catch (NoSuchAlgorithmException e) {
+            // SHA1PRNG is provided by every OpenJDK based platform, fall back to the default otherwise
+            threadRandom = new SecureRandom();
+        }
+        // Seeding before first use replaces SHA1PRNG's self-seeding, so it never reads the system source
+        threadRandom.setSeed(seed);
+        return threadRandom;
+    }
+
+    private Mac newMac() {
+        try {
+            Mac tokenMac = Mac.getInstance(MAC_ALGORITHM);
+            tokenMac.init(key);
+            return tokenMac;
+        } catch (GeneralSecurityException e) {
+            // HmacSHA256 is required of every Java platform
+            throw new IllegalStateException("Unable to initialize session token MAC", e);
+        }
+    }
+}
@@ -7,4 +7,24 @@ package com.aws.greengrass.clientdevices.auth.session.attribute;
 
 public interface DeviceAttribute {
     boolean matches(String expr);
+
+    /**
+     * Match a compiled expression. Attributes which support glob expressions should override this to avoid
+     * recompiling the expression on every match.
+     *
+     * @param pattern compiled expression
+     * @return true if the attribute matches the expression
+     */
+    default boolean matches(GlobPattern pattern) {
+        return matches(pattern.getPattern());
+    }
+
+    /**
+     * Get the literal value of this attribute, e.g. to substitute it for a policy variable.
+     *
+     * @return attribute value, or null if the attribute has no literal value
+     */
+    default String getValue() {
+        return null;
+    }
 }
@@ -0,0 +1,36 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session.attribute;
+
+import lombok.NonNull;
+
+/**
+ * Attribute matching glob expressions with any number of {@code *} wildcards, e.g. {@code site-*-sensor-*}.
+ * Expressions with a single trailing wildcard match as for {@link WildcardSuffixAttribute}.
+ */
+public class GlobAttribute extends WildcardSuffixAttribute {
+
+    public GlobAttribute(String attributeValue) {
+        super(attributeValue);
+    }
+
+    /**
+     * Match an uncompiled expression. The expression is compiled on every call, so callers matching the same
+     * expression repeatedly should compile it once and use {@link #matches(GlobPattern)} instead.
+     */
+    @Override
+    public boolean matches(@NonNull String expr) {
+        if (expr.indexOf(GlobPattern.WILDCARD) < 0) {
+            return getValue().equals(expr);
+        }
+        return GlobPattern.compile(expr).matches(getValue());
+    }
+
+    @Override
+    public boolean matches(GlobPattern pattern) {
+        return pattern.matches(getValue());
+    }
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session.attribute;
+
+import lombok.NonNull;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Compiled glob pattern where {@code *} matches any sequence of characters, e.g. {@code site-*-sensor-*}.
+ *
+ * <p>The pattern is split once into a literal prefix, a literal suffix and the literal segments between
+ * wildcards, each with a precomputed KMP failure table. Segments are matched leftmost-first, which is
+ * sufficient when the only wildcard is {@code *}, so matching is linear in the length of the value and
+ * does not allocate.</p>
+ */
+public final class GlobPattern {
+    public static final char WILDCARD = '*';
+
+    private final String pattern;
+    private final boolean literal;
+    private final String prefix;
+    private final String suffix;
+    private final String[] segments;
+    private final int[][] segmentFailures;
+    private final int minLength;
+
+    private GlobPattern(String pattern) {
+        this.pattern = pattern;
+        int first = pattern.indexOf(WILDCARD);
+        this.literal = first < 0;
+        if (literal) {
+            this.prefix = pattern;
+            this.suffix = "";
+            this.segments = new String[0];
+            this.segmentFailures = new int[0][];
+            this.minLength = pattern.length();
+            return;
+        }
+        int last = pattern.lastIndexOf(WILDCARD);
+        this.prefix = pattern.substring(0, first);
+        this.suffix = pattern.substring(last + 1);
+
+        List<String> middle = new ArrayList<>();
+        int length = prefix.length() + suffix.length();
+        int start = first + 1;
+        while (start <= last) {
+            int end = pattern.indexOf(WILDCARD, start);
+            if (end > start) {
+                // Consecutive wildcards leave empty segments, which match anywhere
+                middle.add(pattern.substring(start, end));
+                length += end - start;
+            }
+            start = end + 1;
+        }
+        this.segments = middle.toArray(new String[0]);
+        this.segmentFailures = new int[segments.length][];
+        for (int i = 0; i < segments.length; i++) {
+            segmentFailures[i] = failureTable(segments[i]);
+        }
+        this.minLength = length;
+    }
+
+    /**
+     * Compile a glob pattern.
+     *
+     * @param pattern pattern, where each {@code *} matches any sequence of characters
+     * @return compiled pattern
+     */
+    public static GlobPattern compile(@NonNull String pattern) {
+        return new GlobPattern(pattern);
+    }
+
+    public String getPattern() {
+        return pattern;
+    }
+
+    /**
+     * Check whether the pattern has no wildcard, so only matches itself.
+     *
+     * @return true if the pattern is a literal
+     */
+    public boolean isLiteral() {
+        return literal;
+    }
+
+    /**
+     * Check whether the pattern is a literal followed by a single trailing wildcard, e.g. {@code sensor-*}.
+     * Such patterns match exactly the values starting with {@link #getPrefix()}.
+     *
+     * @return true if the pattern is a prefix pattern
+     */
+    public boolean isPrefix() {
+        return !literal && prefix.length() == pattern.length() - 1;
+    }
+
+    /**
+     * Get the literal part of the pattern before the first wildcard.
+     *
+     * @return pattern prefix, or the whole pattern if it is a literal
+     */
+    public String getPrefix() {
+        return prefix;
+    }
+
+    /**
+     * Check whether a value matches this pattern.
+     *
+     * @param value value to match
+     * @return true if the whole value matches the pattern
+     */
+    public boolean matches(String value) {
+        if (value == null) {
+            return false;
+        }
+        if (literal) {
+            return pattern.equals(value);
+        }
+        if (value.length() < minLength || !value.startsWith(prefix) || !value.endsWith(suffix)) {
+            return false;
+        }
+        int from = prefix.length();
+        int to = value.length() - suffix.length();
+        for (int i = 0; i < segments.length; i++) {
+            from = indexAfter(value, from, to, i);
+            if (from < 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Find the leftmost occurrence of a segment in value[from, to).
+     *
+     * @return index just past the occurrence, or -1 if there is none
+     */
+    private int indexAfter(String value, int from, int to, int segment) {
+        String literalSegment = segments[segment];
+        int[] failure = segmentFailures[segment];
+        int matched = 0;
+        for (int i = from; i < to; i++) {
+            char c = value.charAt(i);
+            while (matched > 0 && literalSegment.charAt(matched) != c) {
+                matched = failure[matched - 1];
+            }
+            if (literalSegment.charAt(matched) == c) {
+                matched++;
+                if (matched == literalSegment.length()) {
+                    return i + 1;
+                }
+            }
+        }
+        return -1;
+    }
+
+    private static int[] failureTable(String segment) {
+        int[] failure = new int[segment.length()];
+        int matched = 0;
+        for (int i = 1; i < segment.length(); i++) {
+            while (matched > 0 && segment.charAt(matched) != segment.charAt(i)) {
+                matched = failure[matched - 1];
+            }
+            if (segment.charAt(matched) == segment.charAt(i)) {
+                matched++;
+            }
+            failure[i] = matched;
+        }
+        return failure;
+    }
+
+    @Override
+    public String toString() {
+        return pattern;
+    }
+}
@@ -17,6 +17,11 @@ public class StringLiteralAttribute implements DeviceAttribute {
         return value.equals(expr);
     }
 
+    @Override
+    public String getValue() {
+        return value;
+    }
+
     @Override
     public String toString() {
         return value;
@@ -17,12 +17,17 @@ public class WildcardSuffixAttribute implements DeviceAttribute {
     @Override
     public boolean matches(@NonNull String expr) {
         if (expr.endsWith("*")) {
-            return value.startsWith(expr.substring(0, expr.length() - 1));
+            return value.regionMatches(0, expr, 0, expr.length() - 1);
         } else {
             return value.equals(expr);
         }
     }
 
+    @Override
+    public String getValue() {
+        return value;
+    }
+
     @Override
     public String toString() {
         return value;
@@ -11,6 +11,7 @@ import com.aws.greengrass.config.Topics;
 import com.aws.greengrass.dependency.Context;
 import com.aws.greengrass.clientdevices.auth.configuration.GroupManager;
 import com.aws.greengrass.clientdevices.auth.configuration.Permission;
+import com.aws.greengrass.clientdevices.auth.configuration.PermissionIndex;
 import com.aws.greengrass.clientdevices.auth.exception.AuthorizationException;
 import com.aws.greengrass.clientdevices.auth.iot.Certificate;
 import com.aws.greengrass.clientdevices.auth.iot.Component;
@@ -27,11 +28,15 @@ import org.mockito.Mock;
 import org.mockito.junit.jupiter.MockitoExtension;
 
 import java.io.IOException;
+import java.util.Arrays;
 import java.util.Collections;
+import java.util.List;
 
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.is;
 import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.mockito.Mockito.times;
+import static org.mockito.Mockito.verify;
 import static org.mockito.Mockito.when;
 
 @ExtendWith({MockitoExtension.class, GGExtension.class})
@@ -85,16 +90,36 @@ public class DeviceAuthClientTest {
     void GIVEN_sessionHasPermission_WHEN_canDevicePerform_THEN_authorizationReturnTrue() throws Exception {
         Session session = new SessionImpl(new Certificate("certificateId"));
         when(sessionManager.findSession("sessionId")).thenReturn(session);
-        when(groupManager.getApplicablePolicyPermissions(session)).thenReturn(Collections.singletonMap("group1",
-                Collections.singleton(
+        when(groupManager.getApplicablePermissionIndexes(session)).thenReturn(Collections.singletonList(
+                PermissionIndex.compile(Collections.singleton(
                         Permission.builder().operation("mqtt:publish").resource("mqtt:topic:foo").principal("group1")
-                                .build())));
+                                .build()))));
 
         boolean authorized = authClient.canDevicePerform(constructAuthorizationRequest());
 
         assertThat(authorized, is(true));
     }
 
+    @Test
+    void GIVEN_cachedDecision_WHEN_canDevicePerform_THEN_decisionReusedUntilConfigurationChanges() throws Exception {
+        Session session = new SessionImpl(new Certificate("certificateId"));
+        when(sessionManager.findSession("sessionId")).thenReturn(session);
+        when(groupManager.getConfigurationGeneration()).thenReturn(1L, 1L, 2L);
+        when(groupManager.getApplicablePermissionIndexes(session)).thenReturn(Collections.singletonList(
+                PermissionIndex.compile(Collections.singleton(
+                        Permission.builder().operation("mqtt:publish").resource("mqtt:topic:foo").principal("group1")
+                                .build()))));
+
+        assertThat(authClient.canDevicePerform(constructAuthorizationRequest()), is(true));
+        assertThat(authClient.canDevicePerform(constructAuthorizationRequest()), is(true));
+        verify(groupManager, times(1)).getApplicablePermissionIndexes(session);
+        assertThat(session.getAuthorizationDecisionCache().getHitCount(), is(1L));
+
+        // new configuration generation invalidates the cached decision
+        assertThat(authClient.canDevicePerform(constructAuthorizationRequest()), is(true));
+        verify(groupManager, times(2)).getApplicablePermissionIndexes(session);
+    }
+
     @Test
     void GIVEN_internalClientSession_WHEN_canDevicePerform_THEN_authorizationReturnTrue() throws Exception {
         Session session = new SessionImpl(new Certificate("certificateId"));
@@ -106,6 +131,37 @@ public class DeviceAuthClientTest {
         assertThat(authorized, is(true));
     }
 
+    @Test
+    void GIVEN_batchOfRequests_WHEN_canDevicePerformAll_THEN_sessionResolvedOnceAndDecisionsInOrder() throws Exception {
+        Session session = new SessionImpl(new Certificate("certificateId"));
+        when(sessionManager.findSession("sessionId")).thenReturn(session);
+        when(groupManager.getApplicablePermissionIndexes(session)).thenReturn(Collections.singletonList(
+                PermissionIndex.compile(Collections.singleton(
+                        Permission.builder().operation("mqtt:subscribe").resource("mqtt:topicfilter:a/#")
+                                .principal("group1").build()))));
+
+        List<Boolean> decisions = authClient.canDevicePerformAll(Arrays.asList(
+                constructAuthorizationRequest("mqtt:subscribe", "mqtt:topicfilter:a/b"),
+                constructAuthorizationRequest("mqtt:subscribe", "mqtt:topicfilter:c"),
+                constructAuthorizationRequest("mqtt:subscribe", "mqtt:topicfilter:a/+/c")));
+
+        assertThat(decisions, is(Arrays.asList(true, false, true)));
+        verify(sessionManager, times(1)).findSession("sessionId");
+        verify(groupManager, times(1)).getApplicablePermissionIndexes(session);
+    }
+
+    @Test
+    void GIVEN_batchWithInvalidSession_WHEN_canDevicePerformAll_THEN_authorizationExceptionThrown() {
+        when(sessionManager.findSession("sessionId")).thenReturn(null);
+
+        assertThrows(AuthorizationException.class, () -> authClient.canDevicePerformAll(
+                Collections.singletonList(constructAuthorizationRequest())));
+    }
+
+    private AuthorizationRequest constructAuthorizationRequest(String operation, String resource) {
+        return AuthorizationRequest.builder().sessionId("sessionId").operation(operation).resource(resource).build();
+    }
+
     private AuthorizationRequest constructAuthorizationRequest() {
         return AuthorizationRequest.builder().sessionId("sessionId").operation("mqtt:publish")
                 .resource("mqtt:topic:foo").build();
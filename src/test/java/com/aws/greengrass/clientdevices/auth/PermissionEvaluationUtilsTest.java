@@ -6,6 +6,7 @@
 package com.aws.greengrass.clientdevices.auth;
 
 import com.aws.greengrass.clientdevices.auth.configuration.Permission;
+import com.aws.greengrass.clientdevices.auth.configuration.PermissionIndex;
 import com.aws.greengrass.testcommons.testutilities.GGExtension;
 import org.junit.jupiter.api.Test;
 import org.junit.jupiter.api.extension.ExtendWith;
@@ -14,46 +15,140 @@ import org.mockito.junit.jupiter.MockitoExtension;
 import java.util.Arrays;
 import java.util.Collections;
 import java.util.HashSet;
+import java.util.List;
 import java.util.Map;
 import java.util.Set;
+import java.util.stream.Collectors;
 
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.sameInstance;
+import static org.junit.jupiter.api.Assertions.assertThrows;
 
 @ExtendWith({MockitoExtension.class, GGExtension.class})
 class PermissionEvaluationUtilsTest {
 
     @Test
-    void GIVEN_single_group_permission_WHEN_evaluate_operation_permission_THEN_return_decision() {
-        Map<String, Set<Permission>> groupPermissions = prepareGroupPermissionsData();
-        boolean authorized = PermissionEvaluationUtils.isAuthorized("mqtt:publish", "mqtt:topic:a", groupPermissions);
+    void GIVEN_compiled_group_permission_WHEN_evaluate_operation_permission_THEN_return_decision() {
+        List<PermissionIndex> permissionIndexes = prepareGroupPermissionsData().values().stream()
+                .map(PermissionIndex::compile).collect(Collectors.toList());
+        boolean authorized = PermissionEvaluationUtils.isAuthorized("mqtt:publish", "mqtt:topic:a", permissionIndexes);
         assertThat(authorized, is(true));
 
-        authorized = PermissionEvaluationUtils.isAuthorized("mqtt:publish", "mqtt:topic:b", groupPermissions);
+        authorized = PermissionEvaluationUtils.isAuthorized("mqtt:publish", "mqtt:topic:b", permissionIndexes);
         assertThat(authorized, is(true));
 
-        authorized = PermissionEvaluationUtils.isAuthorized("mqtt:subscribe", "mqtt:topic:b", groupPermissions);
+        authorized = PermissionEvaluationUtils.isAuthorized("mqtt:subscribe", "mqtt:topic:b", permissionIndexes);
         assertThat(authorized, is(true));
 
         authorized = PermissionEvaluationUtils.isAuthorized("mqtt:subscribe", "mqtt:topic:$foo/bar/+/baz",
-                groupPermissions);
+                permissionIndexes);
         assertThat(authorized, is(true));
 
         authorized = PermissionEvaluationUtils.isAuthorized("mqtt:subscribe", "mqtt:topic:$foo .10bar/導À-baz/#",
-                groupPermissions);
+                permissionIndexes);
         assertThat(authorized, is(true));
 
         authorized = PermissionEvaluationUtils.isAuthorized("mqtt:connect", "mqtt:broker:localBroker",
-                groupPermissions);
+                permissionIndexes);
         assertThat(authorized, is(true));
 
-        authorized = PermissionEvaluationUtils.isAuthorized("mqtt:publish", "mqtt:topic:d", groupPermissions);
+        authorized = PermissionEvaluationUtils.isAuthorized("mqtt:publish", "mqtt:topic:d", permissionIndexes);
         assertThat(authorized, is(false));
 
-        authorized = PermissionEvaluationUtils.isAuthorized("mqtt:subscribe", "mqtt:message:a", groupPermissions);
+        authorized = PermissionEvaluationUtils.isAuthorized("mqtt:subscribe", "mqtt:message:a", permissionIndexes);
         assertThat(authorized, is(false));
     }
 
+    @Test
+    void GIVEN_mqtt_wildcard_permission_WHEN_evaluate_operation_permission_THEN_topics_matched() {
+        List<PermissionIndex> permissionIndexes = Collections.singletonList(PermissionIndex.compile(Arrays.asList(
+                Permission.builder().principal("sensor").operation("mqtt:publish")
+                        .resource("mqtt:topic:sensors/+/temperature").build(),
+                Permission.builder().principal("sensor").operation("mqtt:subscribe")
+                        .resource("mqtt:topicfilter:sensors/#").build())));
+
+        String[][] expectations = {
+                {"mqtt:publish", "mqtt:topic:sensors/s1/temperature", "true"},
+                {"mqtt:publish", "mqtt:topic:sensors/s1/humidity", "false"},
+                {"mqtt:subscribe", "mqtt:topicfilter:sensors/+/humidity", "true"},
+                {"mqtt:subscribe", "mqtt:topicfilter:#", "false"},
+        };
+        for (String[] expectation : expectations) {
+            assertThat(PermissionEvaluationUtils.isAuthorized(expectation[0], expectation[1], permissionIndexes),
+                    is(Boolean.parseBoolean(expectation[2])));
+        }
+    }
+
+    @Test
+    void GIVEN_deny_permission_in_any_group_WHEN_evaluate_operation_permission_THEN_deny_takes_precedence() {
+        List<PermissionIndex> permissionIndexes = Arrays.asList(
+                PermissionIndex.compile(Collections.singleton(
+                        Permission.builder().principal("all").operation("mqtt:*").resource("*").build())),
+                PermissionIndex.compile(Collections.emptySet(), Collections.singleton(
+                        Permission.builder().principal("restricted").operation("mqtt:publish")
+                                .resource("mqtt:topic:restricted/#").build())));
+
+        assertThat(PermissionEvaluationUtils.isAuthorized("mqtt:publish", "mqtt:topic:restricted/a",
+                permissionIndexes), is(false));
+        assertThat(PermissionEvaluationUtils.isAuthorized("mqtt:subscribe", "mqtt:topic:restricted/a",
+                permissionIndexes), is(true));
+        assertThat(PermissionEvaluationUtils.isAuthorized("mqtt:publish", "mqtt:topic:open",
+                permissionIndexes), is(true));
+    }
+
+    @Test
+    void GIVEN_narrower_deny_WHEN_subscribe_with_wildcards_THEN_overlapping_filters_denied() {
+        List<PermissionIndex> permissionIndexes = Arrays.asList(
+                PermissionIndex.compile(Collections.singleton(
+                        Permission.builder().principal("all").operation("mqtt:subscribe")
+                                .resource("mqtt:topicfilter:#").build())),
+                PermissionIndex.compile(Collections.emptySet(), Arrays.asList(
+                        Permission.builder().principal("restricted").operation("mqtt:subscribe")
+                                .resource("mqtt:topicfilter:secret/#").build(),
+                        Permission.builder().principal("restricted").operation("mqtt:subscribe")
+                                .resource("mqtt:topicfilter:private/x").build())));
+
+        String[][] expectations = {
+                {"mqtt:topicfilter:#", "false"},
+                {"mqtt:topicfilter:+/x", "false"},
+                {"mqtt:topicfilter:+/y", "false"},
+                {"mqtt:topicfilter:secret/a", "false"},
+                {"mqtt:topicfilter:private/+", "false"},
+                {"mqtt:topicfilter:public/+", "true"},
+                {"mqtt:topicfilter:public/y/z", "true"},
+                {"mqtt:topicfilter:private/y", "true"},
+        };
+        for (String[] expectation : expectations) {
+            assertThat(expectation[0], PermissionEvaluationUtils.isAuthorized("mqtt:subscribe", expectation[0],
+                    permissionIndexes), is(Boolean.parseBoolean(expectation[1])));
+        }
+    }
+
+    @Test
+    void GIVEN_operation_and_resource_WHEN_parse_THEN_tokens_are_validated_and_pooled() {
+        PermissionEvaluationUtils.Operation operation = PermissionEvaluationUtils.parseOperation("mqtt:publish");
+        PermissionEvaluationUtils.Resource resource =
+                PermissionEvaluationUtils.parseResource("mqtt:topic:$foo .10bar/導À-baz/#");
+
+        assertThat(operation.getService(), is("mqtt"));
+        assertThat(operation.getAction(), is("publish"));
+        assertThat(resource.getService(), is(sameInstance(operation.getService())));
+        assertThat(resource.getResourceType(), is("topic"));
+        assertThat(resource.getResourceName(), is("$foo .10bar/導À-baz/#"));
+        assertThat(PermissionEvaluationUtils.parseResource("mqtt:clientId:a:b").getResourceName(), is("a:b"));
+
+        for (String invalidOperation : Arrays.asList("", "mqtt", "mqtt:", ":publish", "mqtt:pub:lish", "mq1:pub")) {
+            assertThrows(IllegalArgumentException.class,
+                    () -> PermissionEvaluationUtils.parseOperation(invalidOperation));
+        }
+        for (String invalidResource : Arrays.asList("", "mqtt:topic", "mqtt:topic:", "mqtt::a", "mqtt:top1c:a",
+                "mqtt:topic:a\tb", "mqtt:topic:\u00a9")) {
+            assertThrows(IllegalArgumentException.class,
+                    () -> PermissionEvaluationUtils.parseResource(invalidResource));
+        }
+    }
+
     private Map<String, Set<Permission>> prepareGroupPermissionsData() {
         Permission[] sensorPermission = {
                 Permission.builder().principal("sensor").operation("mqtt:publish").resource("mqtt:topic:a").build(),
@@ -0,0 +1,74 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.api;
+
+import com.aws.greengrass.clientdevices.auth.CertificateManager;
+import com.aws.greengrass.clientdevices.auth.DeviceAuthClient;
+import com.aws.greengrass.clientdevices.auth.iot.CertificateRegistry;
+import com.aws.greengrass.clientdevices.auth.iot.IotAuthClient;
+import com.aws.greengrass.clientdevices.auth.session.SessionManager;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.mockito.Mock;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import java.util.Optional;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+import static org.mockito.Mockito.times;
+import static org.mockito.Mockito.verify;
+import static org.mockito.Mockito.when;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class ClientDevicesAuthServiceApiTest {
+    private static final String CERTIFICATE_PEM = "certificatePem";
+    private static final String CERTIFICATE_ID = "certificateId";
+
+    @Mock
+    private IotAuthClient mockIotAuthClient;
+    @Mock
+    private SessionManager mockSessionManager;
+    @Mock
+    private DeviceAuthClient mockDeviceAuthClient;
+    @Mock
+    private CertificateManager mockCertificateManager;
+
+    private ClientDevicesAuthServiceApi api;
+
+    @BeforeEach
+    void beforeEach() {
+        api = new ClientDevicesAuthServiceApi(new CertificateRegistry(mockIotAuthClient), mockSessionManager,
+                mockDeviceAuthClient, mockCertificateManager, mockIotAuthClient);
+    }
+
+    @Test
+    void GIVEN_verifiedCertificate_WHEN_sessionsInvalidatedForCertificate_THEN_reconnectVerifiedWithCloud() {
+        when(mockIotAuthClient.getActiveCertificateId(CERTIFICATE_PEM)).thenReturn(Optional.of(CERTIFICATE_ID));
+        when(mockSessionManager.invalidateSessionsForCertificate(CERTIFICATE_ID)).thenReturn(1);
+
+        assertThat(api.verifyClientDeviceIdentity(CERTIFICATE_PEM), is(true));
+        assertThat(api.verifyClientDeviceIdentity(CERTIFICATE_PEM), is(true));
+        verify(mockIotAuthClient, times(1)).getActiveCertificateId(CERTIFICATE_PEM);
+
+        assertThat(api.invalidateClientDeviceAuthSessionsForCertificate(CERTIFICATE_ID), is(1));
+        verify(mockIotAuthClient).invalidateCertificate(CERTIFICATE_ID);
+        when(mockIotAuthClient.getActiveCertificateId(CERTIFICATE_PEM)).thenReturn(Optional.empty());
+
+        assertThat(api.verifyClientDeviceIdentity(CERTIFICATE_PEM), is(false));
+        verify(mockIotAuthClient, times(2)).getActiveCertificateId(CERTIFICATE_PEM);
+    }
+
+    @Test
+    void GIVEN_thing_WHEN_sessionsInvalidatedForThing_THEN_cachedAssociationsEvicted() {
+        when(mockSessionManager.invalidateSessionsForThing("thingName")).thenReturn(2);
+
+        assertThat(api.invalidateClientDeviceAuthSessionsForThing("thingName"), is(2));
+        verify(mockIotAuthClient).invalidateThing("thingName");
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ParseException;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.not;
+import static org.hamcrest.Matchers.sameInstance;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class CompiledRuleCacheTest {
+
+    @Test
+    void GIVEN_sameRuleWithDifferentSpacing_WHEN_compile_THEN_parsedOnce() throws ParseException {
+        CompiledRuleCache cache = new CompiledRuleCache(10);
+
+        CompiledRule compiledRule = cache.compile("thingName: a OR thingName: b");
+
+        assertThat(cache.compile("  thingName:  a\tOR thingName: b "), sameInstance(compiledRule));
+        assertThat(cache.getMissCount(), is(1L));
+        assertThat(cache.getHitCount(), is(1L));
+        assertThat(cache.size(), is(1));
+    }
+
+    @Test
+    void GIVEN_cacheAtCapacity_WHEN_compile_THEN_leastRecentlyUsedRuleEvicted() throws ParseException {
+        CompiledRuleCache cache = new CompiledRuleCache(2);
+        CompiledRule first = cache.compile("thingName: a");
+        CompiledRule second = cache.compile("thingName: b");
+        cache.compile("thingName: a");
+
+        cache.compile("thingName: c");
+
+        assertThat(cache.size(), is(2));
+        assertThat(cache.compile("thingName: a"), sameInstance(first));
+        assertThat(cache.compile("thingName: b"), is(not(sameInstance(second))));
+    }
+
+    @Test
+    void GIVEN_invalidRule_WHEN_compile_THEN_exceptionThrownAndNothingCached() {
+        CompiledRuleCache cache = new CompiledRuleCache(10);
+
+        assertThrows(ParseException.class, () -> cache.compile("thingName: a OR"));
+        assertThat(cache.size(), is(0));
+        assertThat(cache.getMissCount(), is(1L));
+    }
+
+    @Test
+    void GIVEN_groupDefinitionsWithSameRule_WHEN_built_THEN_compiledRuleShared() throws ParseException {
+        GroupDefinition first = new GroupDefinition("thingName: shared-rule-thing", "policy1");
+        GroupDefinition second = new GroupDefinition("thingName: shared-rule-thing", "policy2");
+
+        assertThat(second.getExpressionTree(), sameInstance(first.getExpressionTree()));
+        assertThat(second.getRule(), sameInstance(first.getRule()));
+    }
+}
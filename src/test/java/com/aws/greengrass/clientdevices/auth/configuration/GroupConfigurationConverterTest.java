@@ -0,0 +1,125 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.exception.AuthorizationException;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import com.fasterxml.jackson.databind.MapperFeature;
+import com.fasterxml.jackson.databind.ObjectMapper;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.Map;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.not;
+import static org.hamcrest.Matchers.sameInstance;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class GroupConfigurationConverterTest {
+    private static final ObjectMapper OBJECT_MAPPER = new ObjectMapper()
+            .enable(MapperFeature.ACCEPT_CASE_INSENSITIVE_ENUMS, MapperFeature.ACCEPT_CASE_INSENSITIVE_PROPERTIES);
+
+    @Test
+    void GIVEN_unchangedGroupsAndPolicies_WHEN_convert_THEN_compiledDefinitionsAndPermissionsReused()
+            throws AuthorizationException {
+        Map<String, Object> deviceGroups = getDeviceGroups("mqtt:topic:a");
+        GroupConfiguration previous = GroupConfigurationConverter.convert(OBJECT_MAPPER, deviceGroups, null);
+
+        GroupConfiguration updated =
+                GroupConfigurationConverter.convert(OBJECT_MAPPER, getDeviceGroups("mqtt:topic:a"), previous);
+
+        assertThat(updated, is(previous));
+        assertThat(updated.getGeneration(), is(not(previous.getGeneration())));
+        assertThat(updated.getDefinitions().get("group1"), sameInstance(previous.getDefinitions().get("group1")));
+        assertThat(updated.getGroupToPermissionsMap().get("group1"),
+                sameInstance(previous.getGroupToPermissionsMap().get("group1")));
+        assertThat(updated.getGroupToPermissionIndexMap().get("group1"),
+                sameInstance(previous.getGroupToPermissionIndexMap().get("group1")));
+    }
+
+    @Test
+    void GIVEN_changedPolicy_WHEN_convert_THEN_onlyAffectedPermissionsRebuilt() throws AuthorizationException {
+        GroupConfiguration previous =
+                GroupConfigurationConverter.convert(OBJECT_MAPPER, getDeviceGroups("mqtt:topic:a"), null);
+
+        GroupConfiguration updated =
+                GroupConfigurationConverter.convert(OBJECT_MAPPER, getDeviceGroups("mqtt:topic:b"), previous);
+
+        assertThat(updated.getDefinitions().get("group1"), sameInstance(previous.getDefinitions().get("group1")));
+        assertThat(updated.getGroupToPermissionIndexMap().get("group1"),
+                is(not(sameInstance(previous.getGroupToPermissionIndexMap().get("group1")))));
+        assertThat(updated.getGroupToPermissionIndexMap().get("group1")
+                .matches("mqtt", "publish", "topic", "mqtt:topic:b"), is(true));
+        assertThat(updated.getGroupToPermissionIndexMap().get("group2"),
+                sameInstance(previous.getGroupToPermissionIndexMap().get("group2")));
+    }
+
+    @Test
+    @SuppressWarnings("unchecked")
+    void GIVEN_changedSelectionRule_WHEN_convert_THEN_definitionRecompiled() throws AuthorizationException {
+        GroupConfiguration previous =
+                GroupConfigurationConverter.convert(OBJECT_MAPPER, getDeviceGroups("mqtt:topic:a"), null);
+        Map<String, Object> deviceGroups = getDeviceGroups("mqtt:topic:a");
+        ((Map<String, Object>) deviceGroups.get("definitions")).put("group2",
+                getDefinition("thingName: otherThing", "policy2"));
+
+        GroupConfiguration updated = GroupConfigurationConverter.convert(OBJECT_MAPPER, deviceGroups, previous);
+
+        assertThat(updated.getDefinitions().get("group2").getSelectionRule(), is("thingName: otherThing"));
+        assertThat(updated.getDefinitions().get("group2"),
+                is(not(sameInstance(previous.getDefinitions().get("group2")))));
+        assertThat(updated.getGroupToPermissionIndexMap().get("group2"),
+                sameInstance(previous.getGroupToPermissionIndexMap().get("group2")));
+    }
+
+    @Test
+    void GIVEN_unknownConfigurationKey_WHEN_convert_THEN_rejected() throws AuthorizationException {
+        GroupConfiguration previous =
+                GroupConfigurationConverter.convert(OBJECT_MAPPER, getDeviceGroups("mqtt:topic:a"), null);
+        Map<String, Object> deviceGroups = getDeviceGroups("mqtt:topic:a");
+        deviceGroups.put("foo", "bar");
+
+        assertThrows(IllegalArgumentException.class,
+                () -> GroupConfigurationConverter.convert(OBJECT_MAPPER, deviceGroups, previous));
+    }
+
+    private static Map<String, Object> getDeviceGroups(String group1Resource) {
+        Map<String, Object> definitions = new HashMap<>();
+        definitions.put("group1", getDefinition("thingName: thing1", "policy1"));
+        definitions.put("group2", getDefinition("thingName: thing2", "policy2"));
+        Map<String, Object> policies = new HashMap<>();
+        policies.put("policy1", getPolicy(group1Resource));
+        policies.put("policy2", getPolicy("mqtt:topic:c"));
+        Map<String, Object> deviceGroups = new HashMap<>();
+        deviceGroups.put("formatVersion", "2021-03-05");
+        deviceGroups.put("definitions", definitions);
+        deviceGroups.put("policies", policies);
+        return deviceGroups;
+    }
+
+    private static Map<String, Object> getDefinition(String selectionRule, String policyName) {
+        Map<String, Object> definition = new HashMap<>();
+        definition.put("selectionRule", selectionRule);
+        definition.put("policyName", policyName);
+        return definition;
+    }
+
+    private static Map<String, Object> getPolicy(String resource) {
+        Map<String, Object> statement = new HashMap<>();
+        statement.put("effect", "ALLOW");
+        statement.put("operations", Collections.singletonList("mqtt:publish"));
+        statement.put("resources", Collections.singletonList(resource));
+        Map<String, Object> policy = new HashMap<>();
+        policy.put("statement1", statement);
+        return policy;
+    }
+}
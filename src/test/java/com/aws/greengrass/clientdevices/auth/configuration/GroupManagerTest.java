@@ -5,6 +5,8 @@
 
 package com.aws.greengrass.clientdevices.auth.configuration;
 
+import com.aws.greengrass.clientdevices.auth.PermissionEvaluationUtils;
+import com.aws.greengrass.clientdevices.auth.session.GroupMembership;
 import com.aws.greengrass.clientdevices.auth.session.Session;
 import com.aws.greengrass.clientdevices.auth.session.SessionImpl;
 import com.aws.greengrass.clientdevices.auth.configuration.parser.ParseException;
@@ -19,60 +21,61 @@ import org.mockito.junit.jupiter.MockitoExtension;
 import java.util.Collections;
 import java.util.HashMap;
 import java.util.HashSet;
+import java.util.List;
 import java.util.Map;
-import java.util.Set;
 
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.sameInstance;
 
 @ExtendWith({MockitoExtension.class, GGExtension.class})
 public class GroupManagerTest {
     @Test
-    void GIVEN_emptyGroupConfiguration_WHEN_getApplicablePolicyPermissions_THEN_returnEmptySet()
+    void GIVEN_emptyGroupConfiguration_WHEN_getApplicablePermissionIndexes_THEN_returnEmptyList()
             throws AuthorizationException {
         GroupManager groupManager = new GroupManager();
         groupManager.setGroupConfiguration(new GroupConfiguration(null, null, null));
 
-        assertThat(groupManager.getApplicablePolicyPermissions(getSessionFromThing("thingName")),
-                is(Collections.emptyMap()));
+        assertThat(groupManager.getApplicablePermissionIndexes(getSessionFromThing("thingName")).isEmpty(),
+                is(true));
     }
 
     @Test
-    void GIVEN_sessionInNoGroup_WHEN_getApplicablePolicyPermissions_THEN_returnEmptySet()
+    void GIVEN_sessionInNoGroup_WHEN_getApplicablePermissionIndexes_THEN_returnEmptyList()
             throws AuthorizationException, ParseException {
         GroupConfiguration groupConfiguration = GroupConfiguration.builder()
                 .definitions(Collections.singletonMap("group1", getGroupDefinition("differentThingName", "policy1")))
-                .policies(Collections.singletonMap("policy1",
-                        Collections.singletonMap("Statement1", getPolicyStatement("connect", "clientId"))))
+                .policies(Collections.singletonMap("policy1", Collections.singletonMap("Statement1",
+                        getPolicyStatement("mqtt:connect", "mqtt:broker:localBroker"))))
                 .build();
         GroupManager groupManager = new GroupManager();
         groupManager.setGroupConfiguration(groupConfiguration);
 
-        assertThat(groupManager.getApplicablePolicyPermissions(getSessionFromThing("thingName")),
-                is(Collections.emptyMap()));
+        assertThat(groupManager.getApplicablePermissionIndexes(getSessionFromThing("thingName")).isEmpty(),
+                is(true));
     }
 
     @Test
-    void GIVEN_sessionInSingleGroup_WHEN_getApplicablePolicyPermissions_THEN_returnGroupPermissions()
+    void GIVEN_sessionInSingleGroup_WHEN_getApplicablePermissionIndexes_THEN_returnGroupPermissions()
             throws AuthorizationException, ParseException {
         Session session = getSessionFromThing("thingName");
         GroupConfiguration groupConfiguration = GroupConfiguration.builder()
                 .definitions(Collections.singletonMap("group1", getGroupDefinition("thingName", "policy1")))
-                .policies(Collections.singletonMap("policy1",
-                        Collections.singletonMap("Statement1", getPolicyStatement("connect", "clientId"))))
+                .policies(Collections.singletonMap("policy1", Collections.singletonMap("Statement1",
+                        getPolicyStatement("mqtt:connect", "mqtt:broker:localBroker"))))
                 .build();
         GroupManager groupManager = new GroupManager();
-        Map<String, Set<Permission>> permissionsMap = new HashMap<>(
-                Collections.singletonMap("group1",
-                        new HashSet<>(Collections.singleton(new Permission("group1", "connect", "clientId")))));
-
         groupManager.setGroupConfiguration(groupConfiguration);
 
-        assertThat(groupManager.getApplicablePolicyPermissions(session), is(permissionsMap));
+        List<PermissionIndex> permissionIndexes = groupManager.getApplicablePermissionIndexes(session);
+        assertThat(permissionIndexes.size(), is(1));
+        assertThat(permissionIndexes.get(0).matches("mqtt", "connect", "broker", "mqtt:broker:localBroker"),
+                is(true));
+        assertThat(permissionIndexes.get(0).matches("mqtt", "publish", "topic", "mqtt:topic:a"), is(false));
     }
 
     @Test
-    void GIVEN_sessionInMultipleGroups_WHEN_getApplicablePolicyPermissions_THEN_returnMergedGroupPermissions()
+    void GIVEN_sessionInMultipleGroups_WHEN_getApplicablePermissionIndexes_THEN_returnMatchingGroupPermissions()
             throws AuthorizationException, ParseException {
         Session session = getSessionFromThing("thingName");
         GroupConfiguration groupConfiguration = GroupConfiguration.builder()
@@ -82,22 +85,77 @@ public class GroupManagerTest {
                     put("group3", getGroupDefinition("differentThingName", "policy3"));
                 }})
                 .policies(new HashMap<String, Map<String, AuthorizationPolicyStatement>>() {{
-                    put("policy1", Collections.singletonMap("Statement1", getPolicyStatement("connect", "clientId")));
-                    put("policy2", Collections.singletonMap("Statement1", getPolicyStatement("publish", "topic")));
-                    put("policy3", Collections.singletonMap("Statement1", getPolicyStatement("subscribe", "topic")));
+                    put("policy1", Collections.singletonMap("Statement1",
+                            getPolicyStatement("mqtt:connect", "mqtt:broker:localBroker")));
+                    put("policy2", Collections.singletonMap("Statement1",
+                            getPolicyStatement("mqtt:publish", "mqtt:topic:a")));
+                    put("policy3", Collections.singletonMap("Statement1",
+                            getPolicyStatement("mqtt:subscribe", "mqtt:topic:a")));
                 }})
                 .build();
         GroupManager groupManager = new GroupManager();
+        groupManager.setGroupConfiguration(groupConfiguration);
+
+        List<PermissionIndex> permissionIndexes = groupManager.getApplicablePermissionIndexes(session);
+        assertThat(permissionIndexes.size(), is(2));
+        assertThat(PermissionEvaluationUtils.isAuthorized("mqtt:connect", "mqtt:broker:localBroker",
+                permissionIndexes), is(true));
+        assertThat(PermissionEvaluationUtils.isAuthorized("mqtt:publish", "mqtt:topic:a", permissionIndexes),
+                is(true));
+        assertThat(PermissionEvaluationUtils.isAuthorized("mqtt:subscribe", "mqtt:topic:a", permissionIndexes),
+                is(false));
+    }
+
+    @Test
+    void GIVEN_sessionInGroup_WHEN_getApplicablePermissionIndexes_THEN_membershipMemoizedPerConfiguration()
+            throws AuthorizationException, ParseException {
+        Session session = getSessionFromThing("thingName");
+        GroupConfiguration groupConfiguration = GroupConfiguration.builder()
+                .definitions(Collections.singletonMap("group1", getGroupDefinition("thingName", "policy1")))
+                .policies(Collections.singletonMap("policy1",
+                        Collections.singletonMap("Statement1", getPolicyStatement("connect", "clientId"))))
+                .build();
+        GroupManager groupManager = new GroupManager();
+        groupManager.setGroupConfiguration(groupConfiguration);
 
-        Map<String, Set<Permission>> permissionsMap = new HashMap<>();
-        permissionsMap.put("group1",
-                new HashSet<>(Collections.singleton(new Permission("group1", "connect", "clientId"))));
-        permissionsMap.put("group2",
-                new HashSet<>(Collections.singleton(new Permission("group2", "publish", "topic"))));
+        assertThat(groupManager.getApplicablePermissionIndexes(session).size(), is(1));
+        GroupMembership membership = session.getGroupMembership();
+        assertThat(membership.getGeneration(), is(groupConfiguration.getGeneration()));
+        assertThat(groupManager.getApplicablePermissionIndexes(session).size(), is(1));
+        assertThat(session.getGroupMembership(), is(sameInstance(membership)));
+
+        GroupConfiguration newConfiguration = GroupConfiguration.builder()
+                .definitions(Collections.singletonMap("group1", getGroupDefinition("otherThing", "policy1")))
+                .policies(groupConfiguration.getPolicies())
+                .build();
+        groupManager.setGroupConfiguration(newConfiguration);
+
+        assertThat(groupManager.getApplicablePermissionIndexes(session).size(), is(0));
+        assertThat(session.getGroupMembership().getGeneration(), is(newConfiguration.getGeneration()));
+    }
 
+    @Test
+    void GIVEN_denyStatement_WHEN_getApplicablePermissionIndexes_THEN_denyCompiledForGroup()
+            throws AuthorizationException, ParseException {
+        Session session = getSessionFromThing("thingName");
+        Map<String, AuthorizationPolicyStatement> statements = new HashMap<>();
+        statements.put("Allow", getPolicyStatement("mqtt:publish", "mqtt:topic:*"));
+        statements.put("Deny", new AuthorizationPolicyStatement("Deny description",
+                AuthorizationPolicyStatement.Effect.DENY,
+                new HashSet<>(Collections.singleton("mqtt:publish")),
+                new HashSet<>(Collections.singleton("mqtt:topic:secret"))));
+        GroupConfiguration groupConfiguration = GroupConfiguration.builder()
+                .definitions(Collections.singletonMap("group1", getGroupDefinition("thingName", "policy1")))
+                .policies(Collections.singletonMap("policy1", statements))
+                .build();
+        GroupManager groupManager = new GroupManager();
         groupManager.setGroupConfiguration(groupConfiguration);
 
-        assertThat(groupManager.getApplicablePolicyPermissions(session), is(permissionsMap));
+        assertThat(groupConfiguration.getGroupToDenyPermissionsMap().get("group1"), is(Collections.singleton(
+                new Permission("group1", "mqtt:publish", "mqtt:topic:secret"))));
+        PermissionIndex permissionIndex = groupManager.getApplicablePermissionIndexes(session).get(0);
+        assertThat(permissionIndex.denies("mqtt", "publish", "topic", "mqtt:topic:secret"), is(true));
+        assertThat(permissionIndex.matches("mqtt", "publish", "topic", "mqtt:topic:other"), is(true));
     }
 
     private Session getSessionFromThing(String thingName) {
@@ -0,0 +1,95 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ParseException;
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import com.aws.greengrass.clientdevices.auth.session.SessionImpl;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class GroupSelectionIndexTest {
+    private static final List<String> GROUP_NAMES = Arrays.asList("exact", "prefix", "mixed", "all", "and");
+
+    @Test
+    void GIVEN_thingNameRules_WHEN_findMatchingGroups_THEN_sameGroupsAsRuleEvaluation() throws ParseException {
+        Map<String, GroupDefinition> definitions = new HashMap<>();
+        definitions.put("exact", getGroupDefinition("thingName: sensor-1"));
+        definitions.put("prefix", getGroupDefinition("thingName: sensor*"));
+        definitions.put("mixed", getGroupDefinition("thingName: camera-1 OR thingName: cam* OR thingName: sensor-2"));
+        definitions.put("all", getGroupDefinition("thingName: *"));
+        definitions.put("and", getGroupDefinition("thingName: sensor* AND thingName: sensor-1"));
+        GroupSelectionIndex index = GroupSelectionIndex.build(GROUP_NAMES, definitions);
+
+        assertThat(index.getFallbackGroupCount(), is(1));
+        for (String thingName : Arrays.asList("sensor-1", "sensor-2", "sensor", "camera-1", "cam", "other")) {
+            Session session = getSessionFromThing(thingName);
+            assertThat(thingName, index.findMatchingGroups(session), is(evaluateRules(definitions, session)));
+        }
+        assertThat(index.findMatchingGroups(getSessionFromThing("sensor-1")), is(new int[]{0, 1, 3, 4}));
+        assertThat(index.findMatchingGroups(getSessionFromThing("camera-1")), is(new int[]{2, 3}));
+    }
+
+    @Test
+    void GIVEN_globThingNameRules_WHEN_findMatchingGroups_THEN_sameGroupsAsRuleEvaluation() throws ParseException {
+        Map<String, GroupDefinition> definitions = new HashMap<>();
+        definitions.put("exact", getGroupDefinition("thingName: site-1-sensor-1"));
+        definitions.put("prefix", getGroupDefinition("thingName: site-1*"));
+        definitions.put("mixed", getGroupDefinition("thingName: *-camera-* OR thingName: site-*-sensor-*"));
+        definitions.put("all", getGroupDefinition("thingName: **"));
+        definitions.put("and", getGroupDefinition("thingName: site-* AND thingName: *-1"));
+        GroupSelectionIndex index = GroupSelectionIndex.build(GROUP_NAMES, definitions);
+
+        assertThat(index.getFallbackGroupCount(), is(1));
+        for (String thingName : Arrays.asList("site-1-sensor-1", "site-2-sensor-2", "site-1-camera-1", "site-2",
+                "sensor", "other")) {
+            Session session = getSessionFromThing(thingName);
+            assertThat(thingName, index.findMatchingGroups(session), is(evaluateRules(definitions, session)));
+        }
+        assertThat(index.findMatchingGroups(getSessionFromThing("site-2-sensor-2")), is(new int[]{2, 3}));
+    }
+
+    @Test
+    void GIVEN_sessionWithoutThing_WHEN_findMatchingGroups_THEN_noIndexedGroupsMatch() throws ParseException {
+        Map<String, GroupDefinition> definitions = new HashMap<>();
+        definitions.put("exact", getGroupDefinition("thingName: sensor-1"));
+        definitions.put("all", getGroupDefinition("thingName: *"));
+        GroupSelectionIndex index = GroupSelectionIndex.build(Arrays.asList("all", "exact"), definitions);
+
+        assertThat(index.findMatchingGroups(new SessionImpl(new Certificate("FAKE_CERT_ID"))), is(new int[0]));
+    }
+
+    private int[] evaluateRules(Map<String, GroupDefinition> definitions, Session session) {
+        return GROUP_NAMES.stream()
+                .filter(name -> definitions.get(name).containsClientDevice(session))
+                .mapToInt(GROUP_NAMES::indexOf)
+                .toArray();
+    }
+
+    private Session getSessionFromThing(String thingName) {
+        Thing thing = new Thing(thingName);
+        Session session = new SessionImpl(new Certificate("FAKE_CERT_ID"));
+        session.putAttributeProvider(thing.getNamespace(), thing);
+        return session;
+    }
+
+    private GroupDefinition getGroupDefinition(String selectionRule) throws ParseException {
+        return GroupDefinition.builder().selectionRule(selectionRule).policyName("policy").build();
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import com.aws.greengrass.clientdevices.auth.session.SessionImpl;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import java.util.Arrays;
+import java.util.Collections;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class PermissionIndexTest {
+
+    @Test
+    void GIVEN_exactPermission_WHEN_matches_THEN_onlyExactResourceMatches() {
+        PermissionIndex index = PermissionIndex.compile(Collections.singleton(
+                permission("mqtt:publish", "mqtt:topic:a")));
+
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:a"), is(true));
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:b"), is(false));
+        assertThat(index.matches("mqtt", "subscribe", "topic", "mqtt:topic:a"), is(false));
+    }
+
+    @Test
+    void GIVEN_wildcardPermissions_WHEN_matches_THEN_wildcardBucketsAreUsed() {
+        PermissionIndex index = PermissionIndex.compile(Arrays.asList(
+                permission("mqtt:*", "mqtt:topic:b"),
+                permission("mqtt:subscribe", "mqtt:topic:*"),
+                permission("mqtt:connect", "*"),
+                permission("*", "mqtt:message:c")));
+
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:b"), is(true));
+        assertThat(index.matches("mqtt", "subscribe", "topic", "mqtt:topic:anything"), is(true));
+        assertThat(index.matches("mqtt", "subscribe", "message", "mqtt:message:anything"), is(false));
+        assertThat(index.matches("mqtt", "connect", "clientId", "mqtt:clientId:foo"), is(true));
+        assertThat(index.matches("mqtt", "publish", "message", "mqtt:message:c"), is(true));
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:c"), is(false));
+    }
+
+    @Test
+    void GIVEN_malformedPermissions_WHEN_compile_THEN_permissionsNeverMatch() {
+        PermissionIndex index = PermissionIndex.compile(Arrays.asList(
+                permission("connect", "clientId"),
+                permission("mqtt:", "mqtt:topic:a")));
+
+        assertThat(index.matches("mqtt", "connect", "clientId", "mqtt:clientId:clientId"), is(false));
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:a"), is(false));
+    }
+
+    @Test
+    void GIVEN_mqttWildcardPermissions_WHEN_matches_THEN_topicFiltersAreMatched() {
+        PermissionIndex index = PermissionIndex.compile(Arrays.asList(
+                permission("mqtt:publish", "mqtt:topic:sensors/+/temperature"),
+                permission("mqtt:subscribe", "mqtt:topicfilter:devices/#"),
+                permission("mqtt:publish", "mqtt:topic:bad/#/filter"),
+                permission("other:publish", "other:topic:a/+")));
+
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:sensors/s1/temperature"), is(true));
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:sensors/s1/humidity"), is(false));
+        assertThat(index.matches("mqtt", "subscribe", "topicfilter", "mqtt:topicfilter:devices/+/status"), is(true));
+        assertThat(index.matches("mqtt", "subscribe", "topic", "mqtt:topic:devices/d1"), is(false));
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:bad/x/filter"), is(false));
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:bad/#/filter"), is(true));
+        assertThat(index.matches("other", "publish", "topic", "other:topic:a/b"), is(false));
+    }
+
+    @Test
+    void GIVEN_denyPermissions_WHEN_denies_THEN_onlyDenyPermissionsMatch() {
+        PermissionIndex index = PermissionIndex.compile(
+                Collections.singleton(permission("mqtt:publish", "mqtt:topic:*")),
+                Collections.singleton(permission("mqtt:publish", "mqtt:topic:secret/#")));
+
+        assertThat(index.hasDenies(), is(true));
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:secret/a"), is(true));
+        assertThat(index.denies("mqtt", "publish", "topic", "mqtt:topic:secret/a"), is(true));
+        assertThat(index.denies("mqtt", "publish", "topic", "mqtt:topic:public/a"), is(false));
+        assertThat(PermissionIndex.compile(Collections.singleton(permission("mqtt:publish", "*"))).hasDenies(),
+                is(false));
+    }
+
+    @Test
+    void GIVEN_policyVariablePermission_WHEN_matches_THEN_resolvedPerSession() {
+        PermissionIndex index = PermissionIndex.compile(Collections.singleton(
+                permission("mqtt:publish", "mqtt:topic:devices/${iot:Connection.Thing.ThingName}/telemetry")));
+        Session session = new SessionImpl(new Certificate("certificateId"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("thing-1"));
+
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:devices/thing-1/telemetry", session),
+                is(true));
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:devices/thing-2/telemetry", session),
+                is(false));
+        assertThat(index.matches("mqtt", "publish", "topic", "mqtt:topic:devices/thing-1/telemetry"), is(false));
+    }
+
+    @Test
+    void GIVEN_policyVariablePermissionWithWildcards_WHEN_matches_THEN_topicsBelowThingCovered() {
+        PermissionIndex index = PermissionIndex.compile(Arrays.asList(
+                permission("mqtt:subscribe", "mqtt:topicfilter:devices/${iot:Connection.Thing.ThingName}/#"),
+                permission("mqtt:subscribe", "mqtt:topicfilter:${iot:Connection.Thing.ThingName}/+/status"),
+                permission("mqtt:subscribe", "mqtt:topicfilter:groups/${iot:Connection.Thing.ThingName}")),
+                Collections.singleton(permission("mqtt:subscribe",
+                        "mqtt:topicfilter:devices/${iot:Connection.Thing.ThingName}/secret")));
+        Session session = new SessionImpl(new Certificate("certificateId"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("thing-1"));
+
+        assertThat(index.matches("mqtt", "subscribe", "topicfilter", "mqtt:topicfilter:devices/thing-1/a",
+                session), is(true));
+        assertThat(index.matches("mqtt", "subscribe", "topicfilter", "mqtt:topicfilter:devices/thing-2/a",
+                session), is(false));
+        assertThat(index.matches("mqtt", "subscribe", "topicfilter", "mqtt:topicfilter:thing-1/x/status",
+                session), is(true));
+        assertThat(index.matches("mqtt", "subscribe", "topicfilter", "mqtt:topicfilter:groups/thing-1",
+                session), is(true));
+        assertThat(index.denies("mqtt", "subscribe", "topicfilter", "mqtt:topicfilter:devices/thing-1/#",
+                session), is(true));
+        assertThat(index.denies("mqtt", "subscribe", "topicfilter", "mqtt:topicfilter:devices/thing-1/secret",
+                session), is(true));
+        assertThat(index.denies("mqtt", "subscribe", "topicfilter", "mqtt:topicfilter:devices/thing-1/a",
+                session), is(false));
+    }
+
+    private Permission permission(String operation, String resource) {
+        return Permission.builder().principal("group").operation(operation).resource(resource).build();
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import com.aws.greengrass.clientdevices.auth.session.SessionImpl;
+import com.aws.greengrass.clientdevices.auth.session.attribute.AttributeProvider;
+import com.aws.greengrass.clientdevices.auth.session.attribute.DeviceAttribute;
+import com.aws.greengrass.clientdevices.auth.session.attribute.StringLiteralAttribute;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import java.util.Collections;
+import java.util.Map;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.notNullValue;
+import static org.hamcrest.Matchers.nullValue;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class ResourceTemplateTest {
+
+    @Test
+    void GIVEN_thingNameVariable_WHEN_matches_THEN_variableResolvedFromSession() {
+        ResourceTemplate template =
+                ResourceTemplate.compile("mqtt:topic:devices/${iot:Connection.Thing.ThingName}/telemetry");
+        Session session = new SessionImpl(new Certificate("certificateId"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("thing-1"));
+
+        assertThat(template, is(notNullValue()));
+        assertThat(template.matches("mqtt:topic:devices/thing-1/telemetry", session), is(true));
+        assertThat(template.matches("mqtt:topic:devices/thing-2/telemetry", session), is(false));
+        assertThat(template.matches("mqtt:topic:devices/thing-1/telemetry/x", session), is(false));
+        assertThat(template.matches("mqtt:topic:devices/thing-1/telemetry", null), is(false));
+    }
+
+    @Test
+    void GIVEN_variableWithMqttWildcards_WHEN_matches_THEN_resolvedFilterCoversTopics() {
+        ResourceTemplate template =
+                ResourceTemplate.compile("mqtt:topicfilter:devices/${iot:Connection.Thing.ThingName}/#");
+        Session session = new SessionImpl(new Certificate("certificateId"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("thing-1"));
+
+        assertThat(template.getLiteralPrefix(), is("mqtt:topicfilter:devices/"));
+        assertThat(template.matches("mqtt:topicfilter:devices/thing-1/a", session), is(true));
+        assertThat(template.matches("mqtt:topicfilter:devices/thing-1/+/b", session), is(true));
+        assertThat(template.matches("mqtt:topicfilter:devices/thing-1", session), is(true));
+        assertThat(template.matches("mqtt:topicfilter:devices/thing-2/a", session), is(false));
+        assertThat(template.matches("mqtt:topicfilter:devices/+/a", session), is(false));
+        assertThat(template.matches("mqtt:topic:devices/thing-1/a", session), is(false));
+        assertThat(template.overlaps("mqtt:topicfilter:devices/+/a", session), is(true));
+        assertThat(template.overlaps("mqtt:topicfilter:#", session), is(true));
+        assertThat(template.overlaps("mqtt:topicfilter:devices/thing-2/#", session), is(false));
+
+        ResourceTemplate literal =
+                ResourceTemplate.compile("mqtt:topic:devices/${iot:Connection.Thing.ThingName}/secret");
+        assertThat(literal.matches("mqtt:topic:devices/+/secret", session), is(false));
+        assertThat(literal.overlaps("mqtt:topic:devices/+/secret", session), is(true));
+        assertThat(literal.overlaps("mqtt:topic:devices/thing-1/secret", session), is(true));
+        assertThat(literal.overlaps("mqtt:topic:devices/thing-1/public", session), is(false));
+    }
+
+    @Test
+    void GIVEN_wildcardTemplate_WHEN_matchedInPlace_THEN_mqttSemanticsFollowed() {
+        Session session = new SessionImpl(new Certificate("certificateId"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("thing-1"));
+        ResourceTemplate template =
+                ResourceTemplate.compile("mqtt:topicfilter:+/${iot:Connection.Thing.ThingName}/+");
+
+        assertThat(template.getLiteralPrefix(), is("mqtt:topicfilter:"));
+        assertThat(template.matches("mqtt:topicfilter:a/thing-1/b", session), is(true));
+        assertThat(template.matches("mqtt:topicfilter:a/thing-1/+", session), is(true));
+        assertThat(template.matches("mqtt:topicfilter:a/thing-1/#", session), is(false));
+        assertThat(template.matches("mqtt:topicfilter:a/thing-1", session), is(false));
+        assertThat(template.matches("mqtt:topicfilter:a/thing-1/b/c", session), is(false));
+        assertThat(template.matches("mqtt:topicfilter:$SYS/thing-1/b", session), is(false));
+        assertThat(template.overlaps("mqtt:topicfilter:a/#", session), is(true));
+        assertThat(template.overlaps("mqtt:topicfilter:a/+/b", session), is(true));
+        assertThat(template.overlaps("mqtt:topicfilter:a/thing-2/+", session), is(false));
+
+        // Wildcards sharing a level with other text are not wildcards, so the template is only matched exactly
+        ResourceTemplate misplaced =
+                ResourceTemplate.compile("mqtt:topicfilter:a+/${iot:Connection.Thing.ThingName}");
+        assertThat(misplaced.matches("mqtt:topicfilter:a+/thing-1", session), is(true));
+        assertThat(misplaced.matches("mqtt:topicfilter:ab/thing-1", session), is(false));
+
+        // Variable values can't add levels or wildcards to a topic filter
+        ResourceTemplate custom = ResourceTemplate.compile("mqtt:topicfilter:+/${iot:Connection.Custom.Name}/#");
+        session.putAttributeProvider("Custom", customProvider("x/y"));
+        assertThat(custom.matches("mqtt:topicfilter:a/x/y/b", session), is(false));
+        session.putAttributeProvider("Custom", customProvider("+"));
+        assertThat(custom.matches("mqtt:topicfilter:a/b/c", session), is(false));
+        assertThat(custom.matches("mqtt:topicfilter:a/+/c", session), is(false));
+    }
+
+    @Test
+    void GIVEN_unresolvableVariable_WHEN_matches_THEN_noMatch() {
+        ResourceTemplate template = ResourceTemplate.compile("mqtt:clientId:${iot:Connection.Thing.ThingName}");
+        Session session = new SessionImpl(new Certificate("certificateId"));
+
+        assertThat(template.matches("mqtt:clientId:", session), is(false));
+        assertThat(ResourceTemplate.compile("mqtt:clientId:${iot:Connection.Certificate.CertificateId}")
+                .matches("mqtt:clientId:certificateId", session), is(true));
+    }
+
+    @Test
+    void GIVEN_resourceWithoutWellFormedVariables_WHEN_compile_THEN_noTemplate() {
+        assertThat(ResourceTemplate.compile("mqtt:topic:a"), is(nullValue()));
+        assertThat(ResourceTemplate.compile("mqtt:topic:${a"), is(nullValue()));
+        assertThat(ResourceTemplate.compile("mqtt:topic:${other:Variable}"), is(nullValue()));
+        assertThat(ResourceTemplate.compile("mqtt:topic:${iot:Connection.Thing}"), is(nullValue()));
+    }
+
+    private static AttributeProvider customProvider(String name) {
+        return new AttributeProvider() {
+            @Override
+            public String getNamespace() {
+                return "Custom";
+            }
+
+            @Override
+            public Map<String, DeviceAttribute> getDeviceAttributes() {
+                return Collections.singletonMap("Name", new StringLiteralAttribute(name));
+            }
+        };
+    }
+}
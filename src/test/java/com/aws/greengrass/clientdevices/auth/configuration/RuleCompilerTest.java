@@ -0,0 +1,57 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTStart;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ParseException;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.RuleExpression;
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import com.aws.greengrass.clientdevices.auth.session.attribute.GlobAttribute;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.CsvSource;
+import org.mockito.Mockito;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import java.io.StringReader;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+import static org.mockito.ArgumentMatchers.any;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class RuleCompilerTest {
+
+    @ParameterizedTest
+    @CsvSource({
+            "thingName: Thing, Thing",
+            "thingName: Thing1, Thing",
+            "thingName: Thing*, Thing-A",
+            "thingName: Thing OR thingName: Thing1, Thing1",
+            "thingName: Thing AND thingName: Thing1, Thing",
+            "thingName: Thing OR thingName: Thing1 AND thingName: Thing2, Thing",
+            "thingName: Thing AND thingName: Thing1 OR thingName: Thing2, Thing2",
+            "thingName: A OR thingName: B OR thingName: C OR thingName: D, D",
+            "thingName: A OR thingName: B OR thingName: C OR thingName: D, E",
+            "thingName: A* OR thingName: B OR thingName: C AND thingName: C*, C",
+            "thingName: A* OR thingName: B OR thingName: A OR thingName: B*, B-1",
+            "thingName: site-*-sensor-*, site-1-sensor-2",
+            "thingName: site-*-sensor-*, site-1-camera-2",
+            "thingName: A OR thingName: *-sensor OR thingName: B*, site-1-sensor",
+            "thingName: A OR thingName: *-sensor OR thingName: B*, site-1-sensor-2"
+    })
+    void GIVEN_selectionRule_WHEN_compiledRuleEvaluated_THEN_matchesExpressionVisitor(String rule, String thingName)
+            throws ParseException {
+        ASTStart tree = new RuleExpression(new StringReader(rule)).Start();
+        Session session = Mockito.mock(Session.class);
+        Mockito.when(session.getSessionAttribute(any(), any())).thenReturn(new GlobAttribute(thingName));
+
+        Object expected = new ExpressionVisitor().visit(tree, session);
+        assertThat(RuleCompiler.compile(tree).test(session), is(expected));
+        assertThat(RuleCompiler.compile(RuleNormalizer.normalize(tree)).test(session), is(expected));
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTAnd;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTOr;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTStart;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ASTThing;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.Node;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.ParseException;
+import com.aws.greengrass.clientdevices.auth.configuration.parser.RuleExpression;
+import com.aws.greengrass.clientdevices.auth.session.Session;
+import com.aws.greengrass.clientdevices.auth.session.attribute.WildcardSuffixAttribute;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.mockito.Mockito;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import java.io.StringReader;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.instanceOf;
+import static org.hamcrest.Matchers.is;
+import static org.mockito.ArgumentMatchers.any;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class RuleNormalizerTest {
+
+    private static ASTStart parse(String rule) throws ParseException {
+        return new RuleExpression(new StringReader(rule)).Start();
+    }
+
+    private static String thingName(Node node) {
+        return (String) ((ASTThing) node).jjtGetValue();
+    }
+
+    @Test
+    void GIVEN_longOrChain_WHEN_normalize_THEN_singleNaryOrNode() throws ParseException {
+        StringBuilder rule = new StringBuilder("thingName: thing-0");
+        for (int i = 1; i < 500; i++) {
+            rule.append(" OR thingName: thing-").append(i);
+        }
+
+        Node or = RuleNormalizer.normalize(parse(rule.toString())).jjtGetChild(0);
+
+        assertThat(or, instanceOf(ASTOr.class));
+        assertThat(or.jjtGetNumChildren(), is(500));
+        for (int i = 0; i < or.jjtGetNumChildren(); i++) {
+            assertThat(or.jjtGetChild(i), instanceOf(ASTThing.class));
+        }
+    }
+
+    @Test
+    void GIVEN_duplicateTerms_WHEN_normalize_THEN_termsDeduplicatedAndSorted() throws ParseException {
+        Node or = RuleNormalizer.normalize(
+                parse("thingName: b OR thingName: a OR thingName: b OR thingName: a*")).jjtGetChild(0);
+
+        assertThat(or.jjtGetNumChildren(), is(3));
+        assertThat(thingName(or.jjtGetChild(0)), is("a"));
+        assertThat(thingName(or.jjtGetChild(1)), is("a*"));
+        assertThat(thingName(or.jjtGetChild(2)), is("b"));
+    }
+
+    @Test
+    void GIVEN_onlyDuplicateTerms_WHEN_normalize_THEN_singleThingNode() throws ParseException {
+        Node node = RuleNormalizer.normalize(parse("thingName: a AND thingName: a")).jjtGetChild(0);
+
+        assertThat(node, instanceOf(ASTThing.class));
+        assertThat(thingName(node), is("a"));
+    }
+
+    @Test
+    void GIVEN_mixedOperators_WHEN_normalize_THEN_precedencePreserved() throws ParseException {
+        ASTStart tree = parse("thingName: a AND thingName: b OR thingName: c OR thingName: d AND thingName: e");
+
+        Node or = RuleNormalizer.normalize(tree).jjtGetChild(0);
+
+        assertThat(or, instanceOf(ASTOr.class));
+        assertThat(or.jjtGetNumChildren(), is(3));
+        assertThat(thingName(or.jjtGetChild(0)), is("c"));
+        assertThat(or.jjtGetChild(1), instanceOf(ASTAnd.class));
+        assertThat(or.jjtGetChild(2), instanceOf(ASTAnd.class));
+        for (String thing : new String[]{"a", "b", "c", "d", "e", "f"}) {
+            Session session = Mockito.mock(Session.class);
+            Mockito.when(session.getSessionAttribute(any(), any())).thenReturn(new WildcardSuffixAttribute(thing));
+            assertThat(new ExpressionVisitor().visit(RuleNormalizer.normalize(tree), session),
+                    is(new ExpressionVisitor().visit(tree, session)));
+        }
+    }
+}
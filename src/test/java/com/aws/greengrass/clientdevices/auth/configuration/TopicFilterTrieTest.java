@@ -0,0 +1,91 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.configuration;
+
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class TopicFilterTrieTest {
+
+    @Test
+    void GIVEN_topicFilters_WHEN_coversAny_THEN_matchesMqttWildcardSemantics() {
+        TopicFilterTrie trie = new TopicFilterTrie();
+        trie.add("sensors/+/temperature");
+        trie.add("devices/#");
+        trie.add("a/b");
+
+        assertThat(trie.coversAny("sensors/s1/temperature", 0), is(true));
+        assertThat(trie.coversAny("sensors/s1/humidity", 0), is(false));
+        assertThat(trie.coversAny("sensors/s1/temperature/x", 0), is(false));
+        assertThat(trie.coversAny("devices", 0), is(true));
+        assertThat(trie.coversAny("devices/d1/status", 0), is(true));
+        assertThat(trie.coversAny("a/b", 0), is(true));
+        assertThat(trie.coversAny("a/b/c", 0), is(false));
+        assertThat(trie.coversAny("prefix:a/b", 7), is(true));
+    }
+
+    @Test
+    void GIVEN_topicFilters_WHEN_coversAnyFilter_THEN_usesFilterContainment() {
+        TopicFilterTrie trie = new TopicFilterTrie();
+        trie.add("sensors/+/temperature");
+        trie.add("devices/+/#");
+
+        assertThat(trie.coversAny("sensors/+/temperature", 0), is(true));
+        assertThat(trie.coversAny("sensors/#", 0), is(false));
+        assertThat(trie.coversAny("devices/d1/#", 0), is(true));
+        assertThat(trie.coversAny("devices/+/status", 0), is(true));
+        assertThat(trie.coversAny("devices/#", 0), is(false));
+    }
+
+    @Test
+    void GIVEN_topicFilters_WHEN_overlapsAny_THEN_requestedWildcardsMatchNarrowerFilters() {
+        TopicFilterTrie trie = new TopicFilterTrie();
+        trie.add("secret/#");
+        trie.add("a/b");
+        trie.add("$SYS/status");
+
+        assertThat(trie.overlapsAny("#", 0), is(true));
+        assertThat(trie.overlapsAny("+/x", 0), is(true));
+        assertThat(trie.overlapsAny("+/b", 0), is(true));
+        assertThat(trie.overlapsAny("a/#", 0), is(true));
+        assertThat(trie.overlapsAny("a/b/#", 0), is(true));
+        assertThat(trie.overlapsAny("a/c", 0), is(false));
+        assertThat(trie.overlapsAny("+/c/d", 0), is(false));
+        assertThat(trie.overlapsAny("secret", 0), is(true));
+        assertThat(TopicFilterTrie.overlaps("$SYS/status", "#"), is(false));
+        assertThat(TopicFilterTrie.overlaps("$SYS/status", "+/status"), is(false));
+        assertThat(TopicFilterTrie.overlaps("$SYS/status", "$SYS/#"), is(true));
+        assertThat(TopicFilterTrie.overlaps("+/x", "a/+"), is(true));
+    }
+
+    @Test
+    void GIVEN_rootWildcards_WHEN_coversAnySystemTopic_THEN_noMatch() {
+        TopicFilterTrie trie = new TopicFilterTrie();
+        trie.add("#");
+        trie.add("+/status");
+
+        assertThat(trie.coversAny("any/topic", 0), is(true));
+        assertThat(trie.coversAny("$SYS/status", 0), is(false));
+        assertThat(trie.coversAny("$SYS", 0), is(false));
+    }
+
+    @Test
+    void GIVEN_topicFilters_WHEN_isValidFilter_THEN_wildcardsMustOccupyWholeLevels() {
+        assertThat(TopicFilterTrie.isValidFilter("a/+/b"), is(true));
+        assertThat(TopicFilterTrie.isValidFilter("a/#"), is(true));
+        assertThat(TopicFilterTrie.isValidFilter("#"), is(true));
+        assertThat(TopicFilterTrie.isValidFilter("a/#/b"), is(false));
+        assertThat(TopicFilterTrie.isValidFilter("a/b+"), is(false));
+        assertThat(TopicFilterTrie.isValidFilter("a#"), is(false));
+        assertThat(TopicFilterTrie.isValidFilter(""), is(false));
+    }
+}
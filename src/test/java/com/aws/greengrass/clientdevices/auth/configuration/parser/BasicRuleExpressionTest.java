@@ -127,8 +127,10 @@ public class BasicRuleExpressionTest {
     }
 
     @Test
-    void GIVEN_thingNameWithNonTrailingWildcard_WHEN_RuleExpression_THEN_exceptionIsThrown() {
-        expectParseException("thingName: *thing");
-        expectParseException("thingName: thing*2");
+    void GIVEN_thingNameWithNonTrailingWildcard_WHEN_RuleExpression_THEN_ruleIsParsed() throws ParseException {
+        expectValidExpression("thingName: *thing");
+        expectValidExpression("thingName: thing*2");
+        expectValidExpression("thingName: site-*-sensor-*");
+        expectValidExpression("thingName: **");
     }
 }
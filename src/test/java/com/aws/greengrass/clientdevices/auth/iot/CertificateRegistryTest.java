@@ -15,11 +15,16 @@ import org.mockito.Captor;
 import org.mockito.Mock;
 import org.mockito.junit.jupiter.MockitoExtension;
 
+import java.time.Clock;
+import java.time.Duration;
+import java.time.Instant;
+import java.time.ZoneId;
 import java.util.Optional;
 
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.is;
 import static org.mockito.Mockito.anyString;
+import static org.mockito.Mockito.eq;
 import static org.mockito.Mockito.times;
 import static org.mockito.Mockito.verify;
 import static org.mockito.Mockito.when;
@@ -31,6 +36,8 @@ class CertificateRegistryTest {
     private static final String mockCertId = "certificateId";
     @Mock
     private IotAuthClient mockIotAuthClient;
+    @Mock
+    private IotAuthCacheConfig mockCacheConfig;
     @Captor
     private ArgumentCaptor<String> certPemCaptor;
 
@@ -94,4 +101,73 @@ class CertificateRegistryTest {
         assertThat(registry.getIotCertificateIdForPem(mockCertPem), is(Optional.empty()));
         verify(mockIotAuthClient, times(3)).getActiveCertificateId(anyString());
     }
+
+    @Test
+    void GIVEN_cachedCertificateId_WHEN_ttlElapsed_THEN_certificateVerifiedAgain() {
+        when(mockIotAuthClient.getActiveCertificateId(anyString())).thenReturn(Optional.of(mockCertId));
+        when(mockCacheConfig.getCertificateCacheSize()).thenReturn(10);
+        when(mockCacheConfig.getCertificateCacheTtlSeconds()).thenReturn(60L);
+        registry.setCacheConfig(mockCacheConfig);
+        Instant now = Instant.now();
+        registry.setClock(Clock.fixed(now, ZoneId.of("UTC")));
+
+        assertThat(registry.isCertificateValid(mockCertPem), is(true));
+        registry.setClock(Clock.fixed(now.plus(Duration.ofSeconds(59)), ZoneId.of("UTC")));
+        assertThat(registry.isCertificateValid(mockCertPem), is(true));
+        verify(mockIotAuthClient, times(1)).getActiveCertificateId(anyString());
+
+        registry.setClock(Clock.fixed(now.plus(Duration.ofSeconds(60)), ZoneId.of("UTC")));
+        assertThat(registry.isCertificateValid(mockCertPem), is(true));
+        verify(mockIotAuthClient, times(2)).getActiveCertificateId(anyString());
+        assertThat(registry.getCacheHitCount(), is(1L));
+        assertThat(registry.getCacheMissCount(), is(2L));
+    }
+
+    @Test
+    void GIVEN_cacheAtCapacity_WHEN_certificateRegistered_THEN_leastRecentlyUsedEvicted() {
+        when(mockIotAuthClient.getActiveCertificateId(anyString()))
+                .thenAnswer(invocation -> Optional.of("id-" + invocation.getArgument(0)));
+        when(mockCacheConfig.getCertificateCacheSize()).thenReturn(2);
+        when(mockCacheConfig.getCertificateCacheTtlSeconds()).thenReturn(300L);
+        registry.setCacheConfig(mockCacheConfig);
+
+        registry.getIotCertificateIdForPem("pem-1");
+        registry.getIotCertificateIdForPem("pem-2");
+        // pem-1 is used more recently than pem-2, so pem-2 is evicted by pem-3
+        registry.getIotCertificateIdForPem("pem-1");
+        registry.getIotCertificateIdForPem("pem-3");
+
+        assertThat(registry.getIotCertificateIdForPem("pem-1").get(), is("id-pem-1"));
+        assertThat(registry.getIotCertificateIdForPem("pem-3").get(), is("id-pem-3"));
+        verify(mockIotAuthClient, times(1)).getActiveCertificateId(eq("pem-1"));
+        assertThat(registry.getIotCertificateIdForPem("pem-2").get(), is("id-pem-2"));
+        verify(mockIotAuthClient, times(2)).getActiveCertificateId(eq("pem-2"));
+    }
+
+    @Test
+    void GIVEN_zeroTtl_WHEN_isCertificateValid_THEN_cloudCalledEveryTime() {
+        when(mockIotAuthClient.getActiveCertificateId(anyString())).thenReturn(Optional.of(mockCertId));
+        when(mockCacheConfig.getCertificateCacheTtlSeconds()).thenReturn(0L);
+        registry.setCacheConfig(mockCacheConfig);
+
+        assertThat(registry.isCertificateValid(mockCertPem), is(true));
+        assertThat(registry.isCertificateValid(mockCertPem), is(true));
+        verify(mockIotAuthClient, times(2)).getActiveCertificateId(anyString());
+        assertThat(registry.getCacheHitCount(), is(0L));
+    }
+
+    @Test
+    void GIVEN_cachedCertificateId_WHEN_certificateInvalidated_THEN_certificateVerifiedAgain() {
+        when(mockIotAuthClient.getActiveCertificateId(anyString()))
+                .thenAnswer(invocation -> Optional.of("id-" + invocation.getArgument(0)));
+
+        assertThat(registry.isCertificateValid("pem-1"), is(true));
+        assertThat(registry.isCertificateValid("pem-2"), is(true));
+        registry.invalidateCertificate("id-pem-1");
+
+        assertThat(registry.isCertificateValid("pem-1"), is(true));
+        assertThat(registry.isCertificateValid("pem-2"), is(true));
+        verify(mockIotAuthClient, times(2)).getActiveCertificateId(eq("pem-1"));
+        verify(mockIotAuthClient, times(1)).getActiveCertificateId(eq("pem-2"));
+    }
 }
@@ -26,8 +26,17 @@ import software.amazon.awssdk.services.greengrassv2data.model.VerifyClientDevice
 import software.amazon.awssdk.services.greengrassv2data.model.VerifyClientDeviceIoTCertificateAssociationRequest;
 import software.amazon.awssdk.services.greengrassv2data.model.VerifyClientDeviceIoTCertificateAssociationResponse;
 
+import java.time.Clock;
+import java.time.Duration;
+import java.time.Instant;
+import java.time.ZoneId;
+import java.util.ArrayList;
+import java.util.List;
 import java.util.Optional;
 import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
 import java.util.concurrent.TimeUnit;
 
 import static com.aws.greengrass.testcommons.testutilities.ExceptionLogProtector.ignoreExceptionOfType;
@@ -36,6 +45,8 @@ import static org.hamcrest.Matchers.is;
 import static org.junit.jupiter.api.Assertions.assertThrows;
 import static org.mockito.ArgumentMatchers.any;
 import static org.mockito.Mockito.lenient;
+import static org.mockito.Mockito.mock;
+import static org.mockito.Mockito.times;
 import static org.mockito.Mockito.verify;
 import static org.mockito.Mockito.when;
 
@@ -64,6 +75,9 @@ public class IotAuthClientTest {
     @Captor
     private ArgumentCaptor<VerifyClientDeviceIoTCertificateAssociationRequest> associationRequestCaptor;
 
+    @Mock
+    private IotAuthCacheConfig cacheConfig;
+
     @BeforeEach
     void beforeEach() {
         lenient().when(clientFactory.getGreengrassV2DataClient()).thenReturn(client);
@@ -190,4 +204,178 @@ public class IotAuthClientTest {
         assertThrows(IllegalArgumentException.class,
                 () -> iotAuthClient.isThingAttachedToCertificate(thing, certificate));
     }
+
+    @Test
+    void GIVEN_attachedThing_WHEN_isThingAttachedToCertificateRepeated_THEN_cloudCalledOncePerTtl() {
+        when(thing.getThingName()).thenReturn("thingName");
+        when(certificate.getIotCertificateId()).thenReturn("certificateId");
+        when(client.verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class)))
+                .thenReturn(VerifyClientDeviceIoTCertificateAssociationResponse.builder().build());
+        when(cacheConfig.getAssociationCacheTtlSeconds()).thenReturn(60L);
+        when(cacheConfig.getAssociationCacheSize()).thenReturn(10);
+        iotAuthClient.setCacheConfig(cacheConfig);
+        Instant now = Instant.now();
+        iotAuthClient.setClock(Clock.fixed(now, ZoneId.of("UTC")));
+
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        verify(client, times(1)).verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class));
+
+        iotAuthClient.setClock(Clock.fixed(now.plus(Duration.ofSeconds(60)), ZoneId.of("UTC")));
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        verify(client, times(2)).verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class));
+        assertThat(iotAuthClient.getAssociationCacheHitCount(), is(1L));
+        assertThat(iotAuthClient.getAssociationCacheMissCount(), is(2L));
+    }
+
+    @Test
+    void GIVEN_associationCacheFull_WHEN_isThingAttachedToCertificate_THEN_leastRecentlyUsedEvicted() {
+        Thing otherThing = mock(Thing.class);
+        when(thing.getThingName()).thenReturn("thingName");
+        when(otherThing.getThingName()).thenReturn("otherThingName");
+        when(certificate.getIotCertificateId()).thenReturn("certificateId");
+        when(client.verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class)))
+                .thenReturn(VerifyClientDeviceIoTCertificateAssociationResponse.builder().build());
+        when(cacheConfig.getAssociationCacheTtlSeconds()).thenReturn(60L);
+        when(cacheConfig.getAssociationCacheSize()).thenReturn(1);
+        iotAuthClient.setCacheConfig(cacheConfig);
+
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        assertThat(iotAuthClient.isThingAttachedToCertificate(otherThing, certificate), is(true));
+        assertThat(iotAuthClient.isThingAttachedToCertificate(otherThing, certificate), is(true));
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        verify(client, times(3)).verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class));
+    }
+
+    @Test
+    void GIVEN_detachedThing_WHEN_negativeTtlElapsed_THEN_thingAttachedLaterIsAccepted(ExtensionContext context) {
+        ignoreExceptionOfType(context, ValidationException.class);
+        when(thing.getThingName()).thenReturn("thingName");
+        when(certificate.getIotCertificateId()).thenReturn("certificateId");
+        when(client.verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class)))
+                .thenThrow(ValidationException.class)
+                .thenReturn(VerifyClientDeviceIoTCertificateAssociationResponse.builder().build());
+        when(cacheConfig.getAssociationCacheTtlSeconds()).thenReturn(300L);
+        when(cacheConfig.getAssociationNegativeCacheTtlSeconds()).thenReturn(10L);
+        when(cacheConfig.getAssociationCacheSize()).thenReturn(10);
+        iotAuthClient.setCacheConfig(cacheConfig);
+        Instant now = Instant.now();
+        iotAuthClient.setClock(Clock.fixed(now, ZoneId.of("UTC")));
+
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(false));
+        iotAuthClient.setClock(Clock.fixed(now.plus(Duration.ofSeconds(9)), ZoneId.of("UTC")));
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(false));
+
+        iotAuthClient.setClock(Clock.fixed(now.plus(Duration.ofSeconds(10)), ZoneId.of("UTC")));
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        verify(client, times(2)).verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class));
+    }
+
+    @Test
+    void GIVEN_concurrentConnections_WHEN_isThingAttachedToCertificate_THEN_cloudCalledOnce() throws Exception {
+        when(thing.getThingName()).thenReturn("thingName");
+        when(certificate.getIotCertificateId()).thenReturn("certificateId");
+        CountDownLatch callStarted = new CountDownLatch(1);
+        CountDownLatch callReleased = new CountDownLatch(1);
+        when(client.verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class))).thenAnswer(invocation -> {
+                    callStarted.countDown();
+                    callReleased.await(TEST_TIME_OUT_SEC, TimeUnit.SECONDS);
+                    return VerifyClientDeviceIoTCertificateAssociationResponse.builder().build();
+                });
+
+        ExecutorService executor = Executors.newFixedThreadPool(8);
+        try {
+            List<Future<Boolean>> results = new ArrayList<>();
+            results.add(executor.submit(() -> iotAuthClient.isThingAttachedToCertificate(thing, certificate)));
+            assertThat(callStarted.await(TEST_TIME_OUT_SEC, TimeUnit.SECONDS), is(true));
+            for (int i = 0; i < 7; i++) {
+                results.add(executor.submit(() -> iotAuthClient.isThingAttachedToCertificate(thing, certificate)));
+            }
+            callReleased.countDown();
+            for (Future<Boolean> result : results) {
+                assertThat(result.get(TEST_TIME_OUT_SEC, TimeUnit.SECONDS), is(true));
+            }
+        } finally {
+            executor.shutdownNow();
+        }
+        verify(client, times(1)).verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class));
+    }
+
+    @Test
+    void GIVEN_cachedAssociation_WHEN_thingInvalidated_THEN_reconnectVerifiedWithCloud(ExtensionContext context) {
+        ignoreExceptionOfType(context, ValidationException.class);
+        when(thing.getThingName()).thenReturn("thingName");
+        when(certificate.getIotCertificateId()).thenReturn("certificateId");
+        when(client.verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class)))
+                .thenReturn(VerifyClientDeviceIoTCertificateAssociationResponse.builder().build())
+                .thenThrow(ValidationException.class);
+
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        iotAuthClient.invalidateThing("otherThingName");
+        iotAuthClient.invalidateCertificate("otherCertificateId");
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        verify(client, times(1)).verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class));
+
+        iotAuthClient.invalidateThing("thingName");
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(false));
+        verify(client, times(2)).verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class));
+    }
+
+    @Test
+    void GIVEN_cachedAssociation_WHEN_certificateInvalidated_THEN_reconnectVerifiedWithCloud() {
+        when(thing.getThingName()).thenReturn("thingName");
+        when(certificate.getIotCertificateId()).thenReturn("certificateId");
+        when(client.verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class)))
+                .thenReturn(VerifyClientDeviceIoTCertificateAssociationResponse.builder().build());
+
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        iotAuthClient.invalidateCertificate("certificateId");
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        verify(client, times(2)).verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class));
+    }
+
+    @Test
+    void GIVEN_associationCheckInFlight_WHEN_thingInvalidated_THEN_resultNotCached() throws Exception {
+        when(thing.getThingName()).thenReturn("thingName");
+        when(certificate.getIotCertificateId()).thenReturn("certificateId");
+        CountDownLatch callStarted = new CountDownLatch(1);
+        CountDownLatch callReleased = new CountDownLatch(1);
+        when(client.verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class))).thenAnswer(invocation -> {
+                    callStarted.countDown();
+                    callReleased.await(TEST_TIME_OUT_SEC, TimeUnit.SECONDS);
+                    return VerifyClientDeviceIoTCertificateAssociationResponse.builder().build();
+                }).thenReturn(VerifyClientDeviceIoTCertificateAssociationResponse.builder().build());
+
+        ExecutorService executor = Executors.newSingleThreadExecutor();
+        try {
+            Future<Boolean> result =
+                    executor.submit(() -> iotAuthClient.isThingAttachedToCertificate(thing, certificate));
+            assertThat(callStarted.await(TEST_TIME_OUT_SEC, TimeUnit.SECONDS), is(true));
+            iotAuthClient.invalidateThing("thingName");
+            callReleased.countDown();
+            assertThat(result.get(TEST_TIME_OUT_SEC, TimeUnit.SECONDS), is(true));
+        } finally {
+            executor.shutdownNow();
+        }
+
+        assertThat(iotAuthClient.isThingAttachedToCertificate(thing, certificate), is(true));
+        verify(client, times(2)).verifyClientDeviceIoTCertificateAssociation(
+                any(VerifyClientDeviceIoTCertificateAssociationRequest.class));
+    }
 }
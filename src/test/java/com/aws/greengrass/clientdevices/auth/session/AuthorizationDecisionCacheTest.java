@@ -0,0 +1,63 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.nullValue;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class AuthorizationDecisionCacheTest {
+
+    @Test
+    void GIVEN_cachedDecision_WHEN_getWithSameGeneration_THEN_decisionReturned() {
+        AuthorizationDecisionCache cache = new AuthorizationDecisionCache();
+        assertThat(cache.get(1, "mqtt:publish", "mqtt:topic:a"), is(nullValue()));
+
+        cache.put(1, "mqtt:publish", "mqtt:topic:a", true);
+        cache.put(1, "mqtt:publish", "mqtt:topic:b", false);
+
+        assertThat(cache.get(1, "mqtt:publish", "mqtt:topic:a"), is(true));
+        assertThat(cache.get(1, "mqtt:publish", "mqtt:topic:b"), is(false));
+        assertThat(cache.get(1, "mqtt:subscribe", "mqtt:topic:a"), is(nullValue()));
+        assertThat(cache.getHitCount(), is(2L));
+        assertThat(cache.getMissCount(), is(2L));
+    }
+
+    @Test
+    void GIVEN_cachedDecision_WHEN_generationChanges_THEN_decisionDropped() {
+        AuthorizationDecisionCache cache = new AuthorizationDecisionCache();
+        cache.put(1, "mqtt:publish", "mqtt:topic:a", true);
+
+        assertThat(cache.get(2, "mqtt:publish", "mqtt:topic:a"), is(nullValue()));
+        cache.put(2, "mqtt:publish", "mqtt:topic:a", false);
+        assertThat(cache.get(2, "mqtt:publish", "mqtt:topic:a"), is(false));
+
+        // a late decision evaluated against the replaced configuration is not cached
+        cache.put(1, "mqtt:publish", "mqtt:topic:b", true);
+        assertThat(cache.get(2, "mqtt:publish", "mqtt:topic:b"), is(nullValue()));
+    }
+
+    @Test
+    void GIVEN_fullCache_WHEN_put_THEN_sizeStaysBounded() {
+        AuthorizationDecisionCache cache = new AuthorizationDecisionCache(4);
+        for (int i = 0; i < 100; i++) {
+            cache.put(1, "mqtt:publish", "mqtt:topic:" + i, true);
+        }
+        int cached = 0;
+        for (int i = 0; i < 100; i++) {
+            if (cache.get(1, "mqtt:publish", "mqtt:topic:" + i) != null) {
+                cached++;
+            }
+        }
+        assertThat(cached <= 4, is(true));
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Component;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.attribute.AttributeProvider;
+import com.aws.greengrass.clientdevices.auth.session.attribute.DeviceAttribute;
+import com.aws.greengrass.clientdevices.auth.session.attribute.StringLiteralAttribute;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+
+import java.util.Collections;
+import java.util.Map;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.notNullValue;
+import static org.hamcrest.Matchers.nullValue;
+import static org.hamcrest.Matchers.sameInstance;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+@ExtendWith(GGExtension.class)
+class CompactSessionTest {
+
+    @Test
+    void GIVEN_thingSession_WHEN_getSessionAttribute_THEN_attributesAreReturned() {
+        Thing thing = new Thing("MyThing");
+        Session session = new CompactSession(new Certificate("FAKE_CERT_ID"), thing, false);
+
+        assertThat(session.getSessionAttribute(Certificate.NAMESPACE, Certificate.CERTIFICATE_ID_ATTRIBUTE)
+                .getValue(), is("FAKE_CERT_ID"));
+        assertThat(session.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE),
+                is(sameInstance(thing.getDeviceAttributes().get(Thing.THING_NAME_ATTRIBUTE))));
+        assertThat(session.getSessionAttribute(Thing.NAMESPACE, "Unknown"), is(nullValue()));
+        assertThat(session.getSessionAttribute(Component.NAMESPACE, "component"), is(nullValue()));
+        assertThat(session.getAttributeProvider(Thing.NAMESPACE), is(sameInstance(thing)));
+    }
+
+    @Test
+    void GIVEN_componentSession_WHEN_getSessionAttribute_THEN_componentAttributeIsReturned() {
+        Session session = new CompactSession(new Certificate("FAKE_CERT_ID"), null, true);
+
+        assertThat(session.getSessionAttribute(Component.NAMESPACE, "component"), is(notNullValue()));
+        assertThat(session.getAttributeProvider(Thing.NAMESPACE), is(nullValue()));
+    }
+
+    @Test
+    void GIVEN_otherProvider_WHEN_getSessionAttribute_THEN_attributeIsReturned() {
+        AttributeProvider provider = new AttributeProvider() {
+            @Override
+            public String getNamespace() {
+                return "Other";
+            }
+
+            @Override
+            public Map<String, DeviceAttribute> getDeviceAttributes() {
+                return Collections.singletonMap("Name", new StringLiteralAttribute("value"));
+            }
+        };
+        Session session = new CompactSession(new Certificate("FAKE_CERT_ID"), null, false,
+                Collections.singletonMap("Other", provider));
+
+        assertThat(session.getSessionAttribute("Other", "Name").getValue(), is("value"));
+        assertThat(session.getAttributeProvider("Unknown"), is(nullValue()));
+    }
+
+    @Test
+    void GIVEN_compactSession_WHEN_attributeProviderAdded_THEN_throwsUnsupportedOperationException() {
+        Thing thing = new Thing("MyThing");
+        Session session = new CompactSession(new Certificate("FAKE_CERT_ID"), thing, false);
+
+        assertThrows(UnsupportedOperationException.class,
+                () -> session.putAttributeProvider(Thing.NAMESPACE, new Thing("OtherThing")));
+        assertThrows(UnsupportedOperationException.class,
+                () -> session.computeAttributeProviderIfAbsent(Component.NAMESPACE, ns -> new Component()));
+        assertThat(session.computeAttributeProviderIfAbsent(Thing.NAMESPACE, ns -> new Thing("OtherThing")),
+                is(sameInstance(thing)));
+    }
+
+    @Test
+    void GIVEN_compactSession_WHEN_getAuthorizationDecisionCache_THEN_sameCacheReturned() {
+        Session session = new CompactSession(new Certificate("FAKE_CERT_ID"), null, false);
+
+        assertThat(session.getAuthorizationDecisionCache(), is(sameInstance(session.getAuthorizationDecisionCache())));
+    }
+
+    // The footprint of compact sessions is measured by the memory tagged SessionMemoryTest
+    @Test
+    void GIVEN_compactSession_WHEN_comparedWithSessionImpl_THEN_sameAttributesReturned() {
+        Certificate certificate = new Certificate("FAKE_CERT_ID");
+        Thing thing = new Thing("MyThing");
+        Session compactSession = new CompactSession(certificate, thing, false, Collections.emptyMap());
+        Session session = new SessionImpl(certificate);
+        session.putAttributeProvider(Thing.NAMESPACE, thing);
+
+        for (String namespace : new String[]{Certificate.NAMESPACE, Thing.NAMESPACE, Component.NAMESPACE, "Other"}) {
+            assertThat(compactSession.getAttributeProvider(namespace),
+                    is(sameInstance(session.getAttributeProvider(namespace))));
+        }
+        assertThat(compactSession.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE),
+                is(sameInstance(session.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE))));
+        assertThat(compactSession.getSessionAttribute("Other", "Name"), is(nullValue()));
+    }
+}
@@ -26,6 +26,7 @@ import java.util.Optional;
 
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.not;
 import static org.hamcrest.Matchers.notNullValue;
 import static org.mockito.ArgumentMatchers.any;
 import static org.mockito.ArgumentMatchers.anyString;
@@ -94,4 +95,24 @@ public class MqttSessionFactoryTest {
         assertThat(session, is(IsNull.notNullValue()));
         assertThat(session.getSessionAttribute(Component.NAMESPACE, "component"), notNullValue());
     }
+
+    @Test
+    void GIVEN_identicalCredentials_WHEN_getSessionKey_THEN_sameKeyReturned() {
+        Map<String, String> otherPassword = ImmutableMap.of(
+                "certificatePem", "PEM",
+                "clientId", "clientId",
+                "username", "",
+                "password", "other"
+        );
+        Map<String, String> otherClientId = ImmutableMap.of(
+                "certificatePem", "PEM",
+                "clientId", "clientId2",
+                "username", "",
+                "password", ""
+        );
+        String key = mqttSessionFactory.getSessionKey(credentialMap);
+        assertThat(key, is(notNullValue()));
+        assertThat(mqttSessionFactory.getSessionKey(otherPassword), is(key));
+        assertThat(mqttSessionFactory.getSessionKey(otherClientId), is(not(key)));
+    }
 }
@@ -0,0 +1,129 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.lessThanOrEqualTo;
+import static org.hamcrest.Matchers.notNullValue;
+import static org.hamcrest.Matchers.nullValue;
+import static org.mockito.Mockito.mock;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class SessionCacheTest {
+
+    @Test
+    void GIVEN_cacheAtCapacity_WHEN_put_THEN_leastRecentlyUsedSessionEvicted() {
+        SessionCache cache = new SessionCache(() -> 100, () -> 0L, () -> 0L);
+        for (int i = 0; i < 100; i++) {
+            cache.put("session-" + i, mock(Session.class), null, 0);
+        }
+        // Use every session but session-50
+        for (int i = 0; i < 100; i++) {
+            if (i != 50) {
+                assertThat(cache.get("session-" + i, 0), is(notNullValue()));
+            }
+        }
+
+        cache.put("session-100", mock(Session.class), null, 0);
+        assertThat(cache.size(), is(100));
+        assertThat(cache.get("session-50", 0), is(nullValue()));
+        assertThat(cache.get("session-0", 0), is(notNullValue()));
+        assertThat(cache.get("session-100", 0), is(notNullValue()));
+    }
+
+    @Test
+    void GIVEN_capacityReduced_WHEN_put_THEN_cacheShrinksToCapacity() {
+        AtomicInteger capacity = new AtomicInteger(100);
+        SessionCache cache = new SessionCache(capacity::get, () -> 0L, () -> 0L);
+        for (int i = 0; i < 100; i++) {
+            cache.put("session-" + i, mock(Session.class), null, 0);
+        }
+
+        capacity.set(10);
+        cache.put("session-100", mock(Session.class), null, 0);
+        assertThat(cache.size(), is(10));
+        for (int i = 91; i <= 100; i++) {
+            assertThat(cache.get("session-" + i, 0), is(notNullValue()));
+        }
+    }
+
+    @Test
+    void GIVEN_sessionsOfThingsAndCertificates_WHEN_invalidated_THEN_onlyMatchingSessionsRemoved() {
+        SessionCache cache = new SessionCache(() -> 100, () -> 0L, () -> 0L);
+        cache.put("thing-1-cert-1", thingSession("cert-1", "thing-1"), "key-1", 0);
+        cache.put("thing-1-cert-2", thingSession("cert-2", "thing-1"), null, 0);
+        cache.put("thing-2-cert-2", thingSession("cert-2", "thing-2"), null, 0);
+        cache.put("thing-3-cert-3", thingSession("cert-3", "thing-3"), null, 0);
+        // A reused session is invalidated regardless of its references
+        assertThat(cache.reuse("key-1", 0, Long.MAX_VALUE), is("thing-1-cert-1"));
+
+        assertThat(cache.invalidateByThingName("thing-1"), is(2));
+        assertThat(cache.get("thing-1-cert-1", 0), is(nullValue()));
+        assertThat(cache.get("thing-1-cert-2", 0), is(nullValue()));
+        assertThat(cache.reuse("key-1", 0, Long.MAX_VALUE), is(nullValue()));
+        assertThat(cache.size(), is(2));
+
+        assertThat(cache.invalidateByCertificateId("cert-2"), is(1));
+        assertThat(cache.get("thing-2-cert-2", 0), is(nullValue()));
+        assertThat(cache.get("thing-3-cert-3", 0), is(notNullValue()));
+        assertThat(cache.invalidateByThingName("thing-1"), is(0));
+        assertThat(cache.invalidateByCertificateId("unknown"), is(0));
+
+        // Sessions closed otherwise are no longer indexed
+        cache.release("thing-3-cert-3");
+        assertThat(cache.invalidateByCertificateId("cert-3"), is(0));
+        assertThat(cache.size(), is(0));
+    }
+
+    @Test
+    void GIVEN_concurrentReadersAndWriters_WHEN_cacheUsed_THEN_capacityIsRespected() throws Exception {
+        int capacity = 500;
+        SessionCache cache = new SessionCache(() -> capacity, () -> 0L, () -> 0L);
+        Session session = mock(Session.class);
+        ExecutorService executor = Executors.newFixedThreadPool(8);
+        try {
+            List<Future<?>> futures = new ArrayList<>();
+            for (int t = 0; t < 8; t++) {
+                int thread = t;
+                futures.add(executor.submit(() -> {
+                    for (int i = 0; i < 2000; i++) {
+                        String sessionId = "session-" + thread + "-" + i;
+                        cache.put(sessionId, session, null, 0);
+                        cache.get(sessionId, 0);
+                        cache.get("session-" + thread + "-" + (i / 2), 0);
+                    }
+                }));
+            }
+            for (Future<?> future : futures) {
+                future.get(30, TimeUnit.SECONDS);
+            }
+        } finally {
+            executor.shutdownNow();
+        }
+
+        assertThat(cache.size(), is(lessThanOrEqualTo(capacity)));
+    }
+
+    private static Session thingSession(String certificateId, String thingName) {
+        return new CompactSession(new Certificate(certificateId), new Thing(thingName), false);
+    }
+}
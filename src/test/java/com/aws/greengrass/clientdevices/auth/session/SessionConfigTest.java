@@ -20,8 +20,14 @@ import static com.aws.greengrass.componentmanager.KernelConfigResolver.CONFIGURA
 import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.DEFAULT_MAX_ACTIVE_AUTH_TOKENS;
 import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.MAX_ACTIVE_AUTH_TOKENS_TOPIC;
 import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.PERFORMANCE_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.SESSION_IDLE_TIMEOUT_SECONDS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.SESSION_MAX_LIFETIME_SECONDS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.SESSION_REUSE_MAX_AGE_SECONDS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.ClientDevicesAuthService.SIGNED_AUTH_TOKENS_TOPIC;
+import static com.aws.greengrass.clientdevices.auth.session.SessionConfig.DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS;
 import static com.aws.greengrass.clientdevices.auth.session.SessionConfig.MAX_SESSION_CAPACITY;
 import static com.aws.greengrass.clientdevices.auth.session.SessionConfig.MIN_SESSION_CAPACITY;
+import static com.aws.greengrass.clientdevices.auth.session.SessionConfig.NO_SESSION_TIMEOUT;
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.equalTo;
 import static org.hamcrest.Matchers.is;
@@ -82,4 +88,48 @@ class SessionConfigTest {
         configurationTopics.context.waitForPublishQueueToClear();
         assertThat(sessionConfig.getSessionCapacity(), is(equalTo(MIN_SESSION_CAPACITY)));
     }
+
+    @Test
+    public void GIVEN_configured_session_timeouts_WHEN_update_configuration_THEN_returns_updated_timeouts() {
+        assertThat(sessionConfig.getSessionIdleTimeoutSeconds(), is(equalTo(NO_SESSION_TIMEOUT)));
+        assertThat(sessionConfig.getSessionMaxLifetimeSeconds(), is(equalTo(NO_SESSION_TIMEOUT)));
+
+        configurationTopics.lookup(PERFORMANCE_TOPIC, SESSION_IDLE_TIMEOUT_SECONDS_TOPIC).withValue(300);
+        configurationTopics.lookup(PERFORMANCE_TOPIC, SESSION_MAX_LIFETIME_SECONDS_TOPIC).withValue(86400);
+        configurationTopics.context.waitForPublishQueueToClear();
+        assertThat(sessionConfig.getSessionIdleTimeoutSeconds(), is(equalTo(300L)));
+        assertThat(sessionConfig.getSessionMaxLifetimeSeconds(), is(equalTo(86400L)));
+
+        // negative timeouts are disabled
+        configurationTopics.lookup(PERFORMANCE_TOPIC, SESSION_IDLE_TIMEOUT_SECONDS_TOPIC).withValue(-1);
+        configurationTopics.context.waitForPublishQueueToClear();
+        assertThat(sessionConfig.getSessionIdleTimeoutSeconds(), is(equalTo(NO_SESSION_TIMEOUT)));
+    }
+
+    @Test
+    public void GIVEN_configured_session_reuse_age_WHEN_update_configuration_THEN_returns_updated_age() {
+        assertThat(sessionConfig.getSessionReuseMaxAgeSeconds(), is(equalTo(DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS)));
+
+        configurationTopics.lookup(PERFORMANCE_TOPIC, SESSION_REUSE_MAX_AGE_SECONDS_TOPIC).withValue(0);
+        configurationTopics.context.waitForPublishQueueToClear();
+        assertThat(sessionConfig.getSessionReuseMaxAgeSeconds(), is(equalTo(0L)));
+
+        // negative ages fall back to the default
+        configurationTopics.lookup(PERFORMANCE_TOPIC, SESSION_REUSE_MAX_AGE_SECONDS_TOPIC).withValue(-1);
+        configurationTopics.context.waitForPublishQueueToClear();
+        assertThat(sessionConfig.getSessionReuseMaxAgeSeconds(), is(equalTo(DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS)));
+    }
+
+    @Test
+    public void GIVEN_signedAuthTokensConfigured_WHEN_update_configuration_THEN_returns_updated_value() {
+        assertThat(sessionConfig.isSignedAuthTokens(), is(false));
+
+        configurationTopics.lookup(PERFORMANCE_TOPIC, SIGNED_AUTH_TOKENS_TOPIC).withValue(true);
+        configurationTopics.context.waitForPublishQueueToClear();
+        assertThat(sessionConfig.isSignedAuthTokens(), is(true));
+
+        configurationTopics.lookup(PERFORMANCE_TOPIC, SIGNED_AUTH_TOKENS_TOPIC).withValue("false");
+        configurationTopics.context.waitForPublishQueueToClear();
+        assertThat(sessionConfig.isSignedAuthTokens(), is(false));
+    }
 }
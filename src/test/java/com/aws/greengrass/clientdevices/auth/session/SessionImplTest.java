@@ -7,6 +7,7 @@ package com.aws.greengrass.clientdevices.auth.session;
 
 import com.aws.greengrass.clientdevices.auth.iot.Certificate;
 import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.clientdevices.auth.session.attribute.DeviceAttribute;
 import com.aws.greengrass.testcommons.testutilities.GGExtension;
 import org.junit.jupiter.api.Assertions;
 import org.junit.jupiter.api.Test;
@@ -28,4 +29,27 @@ public class SessionImplTest {
         Assertions.assertEquals(session.getSessionAttribute("Thing", "ThingName").toString(),
                 thing.getDeviceAttributes().get("ThingName").toString());
     }
+
+    @Test
+    public void GIVEN_sessionWithThing_WHEN_getSessionAttributeRepeatedly_THEN_sameAttributeReturned() {
+        Session session = new SessionImpl(new Certificate("FAKE_CERT_ID"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("MyThing"));
+
+        DeviceAttribute attribute = session.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE);
+
+        Assertions.assertSame(attribute, session.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE));
+        Assertions.assertNull(session.getSessionAttribute(Thing.NAMESPACE, "Unknown"));
+        Assertions.assertNull(session.getSessionAttribute("Unknown", Thing.THING_NAME_ATTRIBUTE));
+    }
+
+    @Test
+    public void GIVEN_sessionWithThing_WHEN_thingReplaced_THEN_newAttributeReturned() {
+        Session session = new SessionImpl(new Certificate("FAKE_CERT_ID"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("MyThing"));
+
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("OtherThing"));
+
+        Assertions.assertEquals("OtherThing",
+                session.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE).getValue());
+    }
 }
@@ -7,16 +7,26 @@ package com.aws.greengrass.clientdevices.auth.session;
 
 
 import com.aws.greengrass.clientdevices.auth.exception.AuthenticationException;
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
 import com.aws.greengrass.testcommons.testutilities.GGExtension;
 import org.junit.jupiter.api.AfterEach;
 import org.junit.jupiter.api.BeforeEach;
 import org.junit.jupiter.api.Test;
 import org.junit.jupiter.api.extension.ExtendWith;
+import org.junit.jupiter.api.io.TempDir;
 import org.mockito.Mock;
 import org.mockito.junit.jupiter.MockitoExtension;
 import software.amazon.awssdk.utils.ImmutableMap;
 
+import java.io.IOException;
+import java.nio.file.Path;
+import java.time.Clock;
+import java.time.Duration;
+import java.time.Instant;
+import java.time.ZoneOffset;
 import java.util.Map;
+import java.util.concurrent.ScheduledExecutorService;
 
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.nullValue;
@@ -29,6 +39,8 @@ import static org.mockito.Mockito.when;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.lenient;
 import static org.mockito.Mockito.reset;
+import static org.mockito.Mockito.times;
+import static org.mockito.Mockito.verify;
 
 @ExtendWith({MockitoExtension.class, GGExtension.class})
 class SessionManagerTest {
@@ -66,6 +78,8 @@ class SessionManagerTest {
     @BeforeEach
     void beforeEach() throws AuthenticationException {
         lenient().when(mockSessionConfig.getSessionCapacity()).thenReturn(MOCK_SESSION_CAPACITY);
+        lenient().when(mockSessionConfig.getSessionReuseMaxAgeSeconds())
+                .thenReturn(SessionConfig.DEFAULT_SESSION_REUSE_MAX_AGE_SECONDS);
         sessionManager = new SessionManager();
         sessionManager.setSessionConfig(mockSessionConfig);
         SessionCreator.registerSessionFactory(CREDENTIAL_TYPE, mockSessionFactory);
@@ -91,19 +105,70 @@ class SessionManagerTest {
         assertThat(sessionManager.findSession(id2), is(mockSession2));
     }
 
-    // TODO: Re-enable this test
-    /*
     @Test
-    void GIVEN_validDeviceCredentials_WHEN_createSessionTwice_THEN_oldSessionIsRemoved() throws AuthenticationException {
+    void GIVEN_validDeviceCredentials_WHEN_createSessionTwice_THEN_sessionIsReused() throws AuthenticationException {
+        when(mockSessionFactory.getSessionKey(credentialMap)).thenReturn("key");
+        when(mockSessionFactory.getSessionKey(credentialMap2)).thenReturn("key2");
         String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
         String id2 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+        String id3 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap2);
         assertThat(id1, is(not(nullValue())));
-        assertThat(id2, is(not(nullValue())));
-        assertThat(id1, is(not(id2)));
+        assertThat(id2, is(id1));
+        assertThat(id3, is(not(id1)));
+        verify(mockSessionFactory, times(1)).createSession(credentialMap);
+
+        // The session stays open until each client holding it has closed it
+        sessionManager.closeSession(id1);
+        assertThat(sessionManager.findSession(id1), is(mockSession));
+        sessionManager.closeSession(id2);
         assertThat(sessionManager.findSession(id1), is(nullValue()));
-        assertThat(sessionManager.findSession(id2), is(mockSession));
+
+        String id4 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+        assertThat(id4, is(not(id1)));
+        assertThat(sessionManager.findSession(id4), is(mockSession));
+    }
+
+    @Test
+    void GIVEN_reusableSessionPastReuseAge_WHEN_createSession_THEN_credentialsValidatedAgain()
+            throws AuthenticationException {
+        when(mockSessionFactory.getSessionKey(credentialMap)).thenReturn("key");
+        when(mockSessionConfig.getSessionReuseMaxAgeSeconds()).thenReturn(300L);
+        Instant start = Instant.now();
+        sessionManager.setClock(Clock.fixed(start, ZoneOffset.UTC));
+        String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+
+        // Reusing the session does not extend its reuse age
+        sessionManager.setClock(Clock.fixed(start.plusSeconds(299), ZoneOffset.UTC));
+        assertThat(sessionManager.createSession(CREDENTIAL_TYPE, credentialMap), is(id1));
+        sessionManager.setClock(Clock.fixed(start.plusSeconds(300), ZoneOffset.UTC));
+        String id2 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+        assertThat(id2, is(not(id1)));
+        verify(mockSessionFactory, times(2)).createSession(credentialMap);
+
+        // The old session stays valid for the clients holding it, and the new one is reused from now on
+        assertThat(sessionManager.findSession(id1), is(mockSession));
+        assertThat(sessionManager.createSession(CREDENTIAL_TYPE, credentialMap), is(id2));
+
+        // Sessions are never reused if the reuse age is 0
+        when(mockSessionConfig.getSessionReuseMaxAgeSeconds()).thenReturn(0L);
+        assertThat(sessionManager.createSession(CREDENTIAL_TYPE, credentialMap), is(not(id2)));
+        verify(mockSessionFactory, times(3)).createSession(credentialMap);
+    }
+
+    @Test
+    void GIVEN_reusableSessionExpired_WHEN_createSession_THEN_newSessionCreated() throws AuthenticationException {
+        when(mockSessionFactory.getSessionKey(credentialMap)).thenReturn("key");
+        when(mockSessionConfig.getSessionMaxLifetimeSeconds()).thenReturn(60L);
+        Instant start = Instant.now();
+        sessionManager.setClock(Clock.fixed(start, ZoneOffset.UTC));
+        String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+
+        sessionManager.setClock(Clock.fixed(start.plusSeconds(60), ZoneOffset.UTC));
+        String id2 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+        assertThat(id2, is(not(id1)));
+        assertNull(sessionManager.findSession(id1));
+        verify(mockSessionFactory, times(2)).createSession(credentialMap);
     }
-     */
 
     @Test
     void GIVEN_invalidDeviceCredentials_WHEN_createSession_THEN_throwsAuthenticationException() {
@@ -178,6 +243,145 @@ class SessionManagerTest {
         assertThat(sessionManager.findSession(id4), is(mockSession4));
     }
 
+    @Test
+    void GIVEN_sessionIdleTimeout_WHEN_sessionNotLookedUp_THEN_sessionExpires() throws AuthenticationException {
+        when(mockSessionConfig.getSessionIdleTimeoutSeconds()).thenReturn(60L);
+        Instant start = Instant.now();
+        sessionManager.setClock(Clock.fixed(start, ZoneOffset.UTC));
+        String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+        String id2 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap2);
+
+        sessionManager.setClock(Clock.fixed(start.plusSeconds(59), ZoneOffset.UTC));
+        assertThat(sessionManager.findSession(id1), is(mockSession));
+
+        // id2 has been idle for 60 seconds, id1 only for 1
+        sessionManager.setClock(Clock.fixed(start.plusSeconds(60), ZoneOffset.UTC));
+        assertThat(sessionManager.findSession(id1), is(mockSession));
+        assertNull(sessionManager.findSession(id2));
+        assertThat(sessionManager.getSessionCache().size(), is(1));
+
+        sessionManager.setClock(Clock.fixed(start.plusSeconds(120), ZoneOffset.UTC));
+        assertNull(sessionManager.findSession(id1));
+        assertThat(sessionManager.getSessionCache().size(), is(0));
+    }
+
+    @Test
+    void GIVEN_sessionMaxLifetime_WHEN_sessionLookedUp_THEN_sessionExpiresAfterLifetime()
+            throws AuthenticationException {
+        when(mockSessionConfig.getSessionMaxLifetimeSeconds()).thenReturn(60L);
+        Instant start = Instant.now();
+        sessionManager.setClock(Clock.fixed(start, ZoneOffset.UTC));
+        String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+        sessionManager.setClock(Clock.fixed(start.plusSeconds(30), ZoneOffset.UTC));
+        String id2 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap2);
+
+        sessionManager.setClock(Clock.fixed(start.plusSeconds(59), ZoneOffset.UTC));
+        assertThat(sessionManager.findSession(id1), is(mockSession));
+
+        // id1 expires even though it was just looked up
+        sessionManager.setClock(Clock.fixed(start.plusSeconds(60), ZoneOffset.UTC));
+        assertThat(sessionManager.findSession(id2), is(mockSession2));
+        assertNull(sessionManager.findSession(id1));
+        assertThat(sessionManager.getSessionCache().size(), is(1));
+
+        sessionManager.setClock(Clock.fixed(start.plusSeconds(90), ZoneOffset.UTC));
+        assertNull(sessionManager.findSession(id2));
+    }
+
+    @Test
+    void GIVEN_noSessionTimeouts_WHEN_timePasses_THEN_sessionsDoNotExpire() throws AuthenticationException {
+        Instant start = Instant.now();
+        sessionManager.setClock(Clock.fixed(start, ZoneOffset.UTC));
+        String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+
+        sessionManager.setClock(Clock.fixed(start.plus(Duration.ofDays(365)), ZoneOffset.UTC));
+        assertThat(sessionManager.findSession(id1), is(mockSession));
+    }
+
+    @Test
+    void GIVEN_signedAuthTokens_WHEN_findSession_THEN_onlyIssuedTokensAreFound() throws AuthenticationException {
+        when(mockSessionConfig.isSignedAuthTokens()).thenReturn(true);
+        String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+        assertThat(id1.startsWith(SessionTokenSigner.TOKEN_PREFIX), is(true));
+        assertThat(sessionManager.findSession(id1), is(mockSession));
+
+        // Forged and malformed tokens are rejected
+        int middle = id1.length() / 2;
+        String forged = id1.substring(0, middle) + (id1.charAt(middle) == 'A' ? 'B' : 'A') + id1.substring(middle + 1);
+        assertNull(sessionManager.findSession(forged));
+        assertNull(sessionManager.findSession(new SessionTokenSigner().mint()));
+        assertNull(sessionManager.findSession("invalid ID"));
+        assertNull(sessionManager.findSession(null));
+
+        sessionManager.closeSession(id1);
+        assertNull(sessionManager.findSession(id1));
+    }
+
+    @Test
+    void GIVEN_persistedSessions_WHEN_sessionManagerRestarted_THEN_signedTokensStayValid(@TempDir Path workPath)
+            throws AuthenticationException, IOException {
+        Session session = new SessionImpl(new Certificate("certificateId"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("clientId"));
+        when(mockSessionFactory.createSession(credentialMap)).thenReturn(session);
+        when(mockSessionConfig.isSignedAuthTokens()).thenReturn(true);
+        sessionManager.startPersistence(new SessionStore(workPath, mock(ScheduledExecutorService.class)));
+        String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+        String id2 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+        sessionManager.closeSession(id2);
+        sessionManager.stopPersistence();
+
+        SessionManager restartedSessionManager = new SessionManager();
+        restartedSessionManager.setSessionConfig(mockSessionConfig);
+        restartedSessionManager.startPersistence(new SessionStore(workPath, mock(ScheduledExecutorService.class)));
+        Session restored = restartedSessionManager.findSession(id1);
+        assertThat(restored.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE).matches("clientId"),
+                is(true));
+        assertNull(restartedSessionManager.findSession(id2));
+        restartedSessionManager.stopPersistence();
+    }
+
+    @Test
+    void GIVEN_liveSessions_WHEN_persistenceStarted_THEN_signedTokensStayValid(@TempDir Path workPath)
+            throws AuthenticationException, IOException {
+        Session session = new SessionImpl(new Certificate("certificateId"));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("clientId"));
+        when(mockSessionFactory.createSession(credentialMap)).thenReturn(session);
+        when(mockSessionConfig.isSignedAuthTokens()).thenReturn(true);
+        String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+
+        sessionManager.startPersistence(new SessionStore(workPath, mock(ScheduledExecutorService.class)));
+        assertThat(sessionManager.findSession(id1), is(session));
+        String id2 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap2);
+        assertThat(sessionManager.findSession(id2), is(mockSession2));
+        assertNull(sessionManager.findSession(new SessionTokenSigner().mint()));
+
+        // Starting again with the same key keeps the earlier tokens valid too
+        sessionManager.startPersistence(new SessionStore(workPath, mock(ScheduledExecutorService.class)));
+        assertThat(sessionManager.findSession(id1), is(session));
+        assertThat(sessionManager.findSession(id2), is(mockSession2));
+        sessionManager.closeSession(id1);
+        assertNull(sessionManager.findSession(id1));
+        sessionManager.stopPersistence();
+    }
+
+    @Test
+    void GIVEN_sessionsOfThing_WHEN_invalidateSessionsForThing_THEN_sessionsAreRemoved()
+            throws AuthenticationException {
+        when(mockSessionFactory.createSession(credentialMap))
+                .thenReturn(new CompactSession(new Certificate("certificateId"), new Thing("clientId"), false));
+        when(mockSessionFactory.createSession(credentialMap2))
+                .thenReturn(new CompactSession(new Certificate("certificateId2"), new Thing("clientId2"), false));
+        String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
+        String id2 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap2);
+
+        assertThat(sessionManager.invalidateSessionsForThing("clientId"), is(1));
+        assertNull(sessionManager.findSession(id1));
+        assertNotNull(sessionManager.findSession(id2));
+
+        assertThat(sessionManager.invalidateSessionsForCertificate("certificateId2"), is(1));
+        assertNull(sessionManager.findSession(id2));
+    }
+
     @Test
     void GIVEN_validExternalSessionID_WHEN_closeSession_THEN_sessionIsRemoved() throws AuthenticationException {
         String id1 = sessionManager.createSession(CREDENTIAL_TYPE, credentialMap);
@@ -0,0 +1,90 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.logging.api.Logger;
+import com.aws.greengrass.logging.impl.LogManager;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Tag;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+
+import java.util.function.IntFunction;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.lessThan;
+import static org.hamcrest.Matchers.notNullValue;
+
+/**
+ * Measures the heap retained per session, including its certificate and thing. Results are logged, and
+ * are approximate since they are derived from heap usage after garbage collection.
+ *
+ * <p>Excluded from the default unit test run, use {@code mvn test -Dtest=SessionMemoryTest -DexcludedGroups=}.
+ */
+@Tag("memory")
+@ExtendWith(GGExtension.class)
+class SessionMemoryTest {
+    private static final Logger logger = LogManager.getLogger(SessionMemoryTest.class);
+    // Rough upper bound of the heap needed to measure one million compact sessions
+    private static final long MILLION_SESSIONS_HEAP_BYTES = 1024L * 1024 * 1024;
+
+    @Test
+    void GIVEN_thingSessions_WHEN_heapMeasured_THEN_compactSessionsUseLessHeap() {
+        for (int count : new int[]{10_000, 100_000}) {
+            long compactBytes = bytesPerSession(count, SessionMemoryTest::compactSession);
+            long mapBytes = bytesPerSession(count, SessionMemoryTest::mapSession);
+            logger.atInfo().kv("sessions", count).kv("compactBytesPerSession", compactBytes)
+                    .kv("mapBytesPerSession", mapBytes).log("Measured session heap usage");
+            assertThat(compactBytes, is(lessThan(mapBytes)));
+        }
+
+        if (Runtime.getRuntime().maxMemory() < MILLION_SESSIONS_HEAP_BYTES) {
+            logger.atInfo().log("Not enough heap to measure one million sessions");
+            return;
+        }
+        logger.atInfo().kv("sessions", 1_000_000)
+                .kv("compactBytesPerSession", bytesPerSession(1_000_000, SessionMemoryTest::compactSession))
+                .log("Measured session heap usage");
+    }
+
+    private static long bytesPerSession(int count, IntFunction<Session> sessionFactory) {
+        Session[] sessions = new Session[count];
+        long before = usedHeap();
+        for (int i = 0; i < count; i++) {
+            sessions[i] = sessionFactory.apply(i);
+        }
+        long after = usedHeap();
+        // Keep the sessions reachable until the heap has been measured
+        assertThat(sessions[count - 1], is(notNullValue()));
+        return (after - before) / count;
+    }
+
+    private static long usedHeap() {
+        Runtime runtime = Runtime.getRuntime();
+        for (int i = 0; i < 3; i++) {
+            System.gc();
+        }
+        return runtime.totalMemory() - runtime.freeMemory();
+    }
+
+    private static Session compactSession(int i) {
+        return new CompactSession(new Certificate(certificateId(i)), new Thing("thing-" + i), false);
+    }
+
+    private static Session mapSession(int i) {
+        Session session = new SessionImpl(new Certificate(certificateId(i)));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing("thing-" + i));
+        return session;
+    }
+
+    // IoT certificate IDs are 64 hex characters
+    private static String certificateId(int i) {
+        return String.format("%064x", i);
+    }
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import com.aws.greengrass.clientdevices.auth.iot.Certificate;
+import com.aws.greengrass.clientdevices.auth.iot.Component;
+import com.aws.greengrass.clientdevices.auth.iot.Thing;
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.junit.jupiter.api.io.TempDir;
+
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.concurrent.ScheduledExecutorService;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.equalTo;
+import static org.hamcrest.Matchers.instanceOf;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.lessThan;
+import static org.hamcrest.Matchers.not;
+import static org.hamcrest.Matchers.notNullValue;
+import static org.hamcrest.Matchers.nullValue;
+import static org.mockito.Mockito.mock;
+
+@ExtendWith(GGExtension.class)
+class SessionStoreTest {
+    private static final long NOW = 1_000_000L;
+
+    @TempDir
+    Path tmpPath;
+
+    private SessionCache sessionCache;
+    private SessionStore sessionStore;
+
+    @BeforeEach
+    void beforeEach() throws IOException {
+        sessionCache = newCache();
+        sessionStore = new SessionStore(tmpPath, mock(ScheduledExecutorService.class));
+        sessionStore.open(sessionCache, NOW);
+    }
+
+    @AfterEach
+    void afterEach() {
+        sessionStore.close();
+    }
+
+    @Test
+    void GIVEN_sessionsChanged_WHEN_storeReopened_THEN_liveSessionsRestored() throws IOException {
+        sessionCache.put("thing-session", thingSession("cert-1", "thing-1"), "key-1", NOW);
+        sessionCache.put("component-session", componentSession("cert-2"), null, NOW);
+        sessionCache.put("closed-session", thingSession("cert-3", "thing-3"), null, NOW);
+        assertThat(sessionCache.reuse("key-1", NOW, Long.MAX_VALUE), is("thing-session"));
+        sessionCache.release("closed-session");
+        sessionStore.close();
+
+        SessionCache restoredCache = reopen();
+        assertThat(restoredCache.size(), is(2));
+        assertThat(claim(restoredCache, "closed-session"), is(nullValue()));
+        Session thingSession = claim(restoredCache, "thing-session");
+        assertThat(thingSession, is(notNullValue()));
+        assertThat(thingSession.getSessionAttribute(Thing.NAMESPACE, Thing.THING_NAME_ATTRIBUTE).matches("thing-1"),
+                is(true));
+        assertThat(thingSession.getSessionAttribute(Certificate.NAMESPACE, Certificate.CERTIFICATE_ID_ATTRIBUTE)
+                .matches("cert-1"), is(true));
+        assertThat(claim(restoredCache, "component-session").getAttributeProvider(Component.NAMESPACE),
+                is(instanceOf(Component.class)));
+
+        // Both references to the reused session were restored
+        assertThat(restoredCache.reuse("key-1", NOW, Long.MAX_VALUE), is("thing-session"));
+        restoredCache.release("thing-session");
+        restoredCache.release("thing-session");
+        assertThat(restoredCache.get("thing-session", NOW), is(notNullValue()));
+        restoredCache.release("thing-session");
+        assertThat(restoredCache.get("thing-session", NOW), is(nullValue()));
+    }
+
+    @Test
+    void GIVEN_tamperedLog_WHEN_storeReopened_THEN_sessionsAfterTamperingDiscarded() throws IOException {
+        sessionCache.put("session-1", thingSession("cert-1", "thing-1"), null, NOW);
+        sessionCache.put("session-2", thingSession("cert-2", "thing-2"), null, NOW);
+        sessionStore.close();
+
+        Path logPath = tmpPath.resolve(SessionStore.SESSION_LOG_FILENAME);
+        byte[] log = Files.readAllBytes(logPath);
+        log[log.length - 1] ^= 1;
+        Files.write(logPath, log);
+
+        SessionCache restoredCache = reopen();
+        assertThat(claim(restoredCache, "session-1"), is(notNullValue()));
+        assertThat(claim(restoredCache, "session-2"), is(nullValue()));
+    }
+
+    @Test
+    void GIVEN_persistedSessions_WHEN_storeReopened_THEN_onlySessionIdsClaimSessions() throws IOException {
+        sessionCache.put("session-1", thingSession("cert-1", "thing-1"), "key-1", NOW);
+        sessionStore.close();
+        String log = new String(Files.readAllBytes(tmpPath.resolve(SessionStore.SESSION_LOG_FILENAME)),
+                StandardCharsets.ISO_8859_1);
+        assertThat(log.contains("session-1"), is(false));
+
+        SessionCache restoredCache = reopen();
+        String restoredId = sessionStore.restoredIdFor("session-1");
+        assertThat(restoredCache.containsKey(restoredId), is(true));
+
+        // Unclaimed sessions can not be used, even with their persisted ID
+        assertThat(restoredCache.get(restoredId, NOW), is(nullValue()));
+        assertThat(restoredCache.reuse("key-1", NOW, Long.MAX_VALUE), is(nullValue()));
+        assertThat(sessionStore.restoredIdFor(restoredId), is(nullValue()));
+        assertThat(restoredCache.get("session-1", NOW), is(nullValue()));
+
+        assertThat(claim(restoredCache, "session-1"), is(notNullValue()));
+        assertThat(restoredCache.hasUnclaimedSessions(), is(false));
+        assertThat(restoredCache.containsKey(restoredId), is(false));
+        assertThat(restoredCache.get("session-1", NOW), is(notNullValue()));
+        assertThat(restoredCache.reuse("key-1", NOW, Long.MAX_VALUE), is("session-1"));
+        assertThat(claim(restoredCache, "session-1"), is(nullValue()));
+
+        // Claimed sessions are persisted under the same ID
+        restoredCache.release("session-1");
+        sessionStore.close();
+        SessionCache reopenedCache = reopen();
+        assertThat(claim(reopenedCache, "session-1"), is(notNullValue()));
+        reopenedCache.release("session-1");
+        assertThat(reopenedCache.get("session-1", NOW), is(nullValue()));
+    }
+
+    @Test
+    void GIVEN_manySessionsClosed_WHEN_flush_THEN_logIsCompacted() throws IOException {
+        sessionCache.put("live-session", thingSession("cert-1", "thing-1"), null, NOW);
+        for (int i = 0; i < SessionStore.MIN_COMPACTION_RECORDS; i++) {
+            sessionCache.put("session-" + i, thingSession("cert-" + i, "thing-" + i), null, NOW);
+            sessionCache.release("session-" + i);
+        }
+        sessionStore.flush();
+        assertThat(Files.size(tmpPath.resolve(SessionStore.SESSION_LOG_FILENAME)), is(lessThan(1000L)));
+
+        sessionStore.close();
+        SessionCache restoredCache = reopen();
+        assertThat(restoredCache.size(), is(1));
+        assertThat(claim(restoredCache, "live-session"), is(notNullValue()));
+    }
+
+    @Test
+    void GIVEN_persistedSessions_WHEN_deleted_THEN_sessionsNotRestoredOnceReenabled() throws IOException {
+        sessionCache.put("session-1", thingSession("cert-1", "thing-1"), null, NOW);
+        byte[] tokenKey = sessionStore.getTokenKey();
+        sessionStore.close();
+
+        // Persistence disabled on the next run
+        SessionStore disabledStore = new SessionStore(tmpPath, mock(ScheduledExecutorService.class));
+        disabledStore.delete();
+        assertThat(Files.exists(tmpPath.resolve(SessionStore.SESSION_LOG_FILENAME)), is(false));
+        assertThat(Files.exists(tmpPath.resolve(SessionStore.SESSION_KEY_FILENAME)), is(false));
+
+        // Persistence enabled again later
+        SessionCache restoredCache = reopen();
+        assertThat(restoredCache.size(), is(0));
+        assertThat(sessionStore.getTokenKey(), is(not(equalTo(tokenKey))));
+    }
+
+    @Test
+    void GIVEN_store_WHEN_getTokenKey_THEN_keyIsPersisted() throws IOException {
+        byte[] tokenKey = sessionStore.getTokenKey();
+        assertThat(tokenKey.length, is(SessionTokenSigner.KEY_LENGTH));
+        SessionStore reopenedStore = new SessionStore(tmpPath, mock(ScheduledExecutorService.class));
+        assertThat(reopenedStore.getTokenKey(), is(equalTo(tokenKey)));
+    }
+
+    private SessionCache reopen() throws IOException {
+        SessionCache restoredCache = newCache();
+        sessionStore = new SessionStore(tmpPath, mock(ScheduledExecutorService.class));
+        sessionStore.open(restoredCache, NOW);
+        return restoredCache;
+    }
+
+    private Session claim(SessionCache cache, String sessionId) {
+        return cache.claim(sessionStore.restoredIdFor(sessionId), sessionId, NOW);
+    }
+
+    private static SessionCache newCache() {
+        return new SessionCache(() -> 10_000, () -> 0L, () -> 0L);
+    }
+
+    private static Session thingSession(String certificateId, String thingName) {
+        Session session = new SessionImpl(new Certificate(certificateId));
+        session.putAttributeProvider(Thing.NAMESPACE, new Thing(thingName));
+        return session;
+    }
+
+    private static Session componentSession(String certificateId) {
+        Session session = new SessionImpl(new Certificate(certificateId));
+        session.putAttributeProvider(Component.NAMESPACE, new Component());
+        return session;
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session;
+
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+import java.util.UUID;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+
+@ExtendWith(GGExtension.class)
+class SessionTokenSignerTest {
+    private final SessionTokenSigner signer = new SessionTokenSigner();
+
+    @Test
+    void GIVEN_mintedTokens_WHEN_verify_THEN_tokensAreValidAndUnique() {
+        Set<String> tokens = new HashSet<>();
+        for (int i = 0; i < 1000; i++) {
+            String token = signer.mint();
+            assertThat(signer.verify(token), is(true));
+            tokens.add(token);
+        }
+        assertThat(tokens.size(), is(1000));
+    }
+
+    @Test
+    void GIVEN_tokensMintedOnManyThreads_WHEN_verify_THEN_tokensAreValidAndUnique() throws Exception {
+        Set<String> tokens = Collections.synchronizedSet(new HashSet<>());
+        ExecutorService executor = Executors.newFixedThreadPool(8);
+        try {
+            List<Future<?>> futures = new ArrayList<>();
+            for (int t = 0; t < 8; t++) {
+                futures.add(executor.submit(() -> {
+                    for (int i = 0; i < 1000; i++) {
+                        String token = signer.mint();
+                        assertThat(signer.verify(token), is(true));
+                        tokens.add(token);
+                    }
+                }));
+            }
+            for (Future<?> future : futures) {
+                future.get(30, TimeUnit.SECONDS);
+            }
+        } finally {
+            executor.shutdownNow();
+        }
+        // Each thread's generator is seeded independently
+        assertThat(tokens.size(), is(8000));
+    }
+
+    @Test
+    void GIVEN_tamperedToken_WHEN_verify_THEN_tokenIsRejected() {
+        String token = signer.mint();
+        for (int i = SessionTokenSigner.TOKEN_PREFIX.length(); i < token.length() - 1; i++) {
+            char replacement = token.charAt(i) == 'A' ? 'B' : 'A';
+            String tampered = token.substring(0, i) + replacement + token.substring(i + 1);
+            assertThat(tampered, signer.verify(tampered), is(false));
+        }
+    }
+
+    @Test
+    void GIVEN_tokenFromAnotherSigner_WHEN_verify_THEN_tokenIsRejected() {
+        assertThat(signer.verify(new SessionTokenSigner().mint()), is(false));
+    }
+
+    @Test
+    void GIVEN_malformedToken_WHEN_verify_THEN_tokenIsRejected() {
+        String token = signer.mint();
+        assertThat(signer.verify(null), is(false));
+        assertThat(signer.verify(""), is(false));
+        assertThat(signer.verify(UUID.randomUUID().toString()), is(false));
+        assertThat(signer.verify(token.substring(0, token.length() - 1)), is(false));
+        assertThat(signer.verify(token + "A"), is(false));
+        assertThat(signer.verify("s2." + token.substring(3)), is(false));
+        assertThat(signer.verify(token.substring(0, 10) + "!" + token.substring(11)), is(false));
+    }
+}
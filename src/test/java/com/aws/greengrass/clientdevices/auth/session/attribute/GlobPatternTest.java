@@ -0,0 +1,66 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package com.aws.greengrass.clientdevices.auth.session.attribute;
+
+import com.aws.greengrass.testcommons.testutilities.GGExtension;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.CsvSource;
+import org.mockito.junit.jupiter.MockitoExtension;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+
+@ExtendWith({MockitoExtension.class, GGExtension.class})
+class GlobPatternTest {
+
+    @ParameterizedTest
+    @CsvSource({
+            "Value, Value, true",
+            "Value, Valu, false",
+            "Valu*, Value, true",
+            "Value*, Value, true",
+            "*, Value, true",
+            "*, '', true",
+            "**, Value, true",
+            "*lue, Value, true",
+            "*lue, Valu, false",
+            "V*e, Value, true",
+            "V*e, Ve, true",
+            "V*e, Vx, false",
+            "site-*-sensor-*, site-1-sensor-2, true",
+            "site-*-sensor-*, site-1-sensor-, true",
+            "site-*-sensor-*, site--sensor-, true",
+            "site-*-sensor-*, site-1-camera-2, false",
+            "site-*-sensor-*, site-sensor-2, false",
+            "*aab*, xaaab, true",
+            "*abab*c, xabaabac, false",
+            "*abab*c, xabababc, true",
+            "a*a*a, aa, false",
+            "a*a*a, aaa, true"
+    })
+    void GIVEN_globPattern_WHEN_matches_THEN_returnsExpected(String pattern, String value, boolean expected) {
+        assertThat(pattern + " ~ " + value, GlobPattern.compile(pattern).matches(value), is(expected));
+        assertThat(pattern + " ~ " + value, new GlobAttribute(value).matches(pattern), is(expected));
+    }
+
+    @Test
+    void GIVEN_globPatterns_WHEN_classified_THEN_literalAndPrefixPatternsDetected() {
+        assertThat(GlobPattern.compile("thing").isLiteral(), is(true));
+        assertThat(GlobPattern.compile("thing*").isLiteral(), is(false));
+        assertThat(GlobPattern.compile("thing*").isPrefix(), is(true));
+        assertThat(GlobPattern.compile("thing*").getPrefix(), is("thing"));
+        assertThat(GlobPattern.compile("*").isPrefix(), is(true));
+        assertThat(GlobPattern.compile("thing**").isPrefix(), is(false));
+        assertThat(GlobPattern.compile("th*ng*").isPrefix(), is(false));
+    }
+
+    @Test
+    void GIVEN_globPattern_WHEN_matchesNull_THEN_returnsFalse() {
+        assertThat(GlobPattern.compile("*").matches(null), is(false));
+    }
+}